@@ -9,21 +9,36 @@ abstractObject::abstractObject() {
   idObject="";
   objectLevel=0;
   objectGroupPointer=NULL;
+  indexInGroup=0;
   osPtrSel=NULL;
   osPtrDbg=NULL;
+  paramsNumPtr=NULL;
+  inputsSimPtr=NULL;
+  outputsPtr=NULL;
+  paramsFunCursors=NULL;
+  sharedParamsFunCursors=NULL;
+  nSharedParamsFun=0;
+  nParamsNum=0;
+  nInputsSim=0;
+  nOutputs=0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Destructor
 ////////////////////////////////////////////////////////////////////////////////
 abstractObject::~abstractObject() {
-  paramsNum.clear();
+  // Note: The storage of individual scalar parameters, simulated inputs,
+  //       outputs, function cursors, and vector states is released by the
+  //       object group.
   paramsFun.clear();
   clear_inputsExt();
-  inputsSim.clear();
   statesScal.clear();
   statesVect.clear();
-  outputs.clear();
+  paramsFunCursors=NULL;
+  sharedParamsFunCursors=NULL;
+  paramsNumPtr=NULL;
+  inputsSimPtr=NULL;
+  outputsPtr=NULL;
   forwardInputObjectPointers.clear();
   backwardInputObjectPointers.clear();
   objectGroupPointer=NULL;
@@ -39,6 +54,84 @@ abstractObject::~abstractObject() {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Allocation of storage for individual scalar parameters, simulated inputs,
+// and outputs (default: use the object's slot in the storage of the group)
+////////////////////////////////////////////////////////////////////////////////
+void abstractObject::allocate_paramsNum(const unsigned int n) {
+  bind_paramsNum(n == 0 ? NULL : objectGroupPointer->storage_paramsNum(indexInGroup), n);
+}
+void abstractObject::allocate_inputsSim(const unsigned int n) {
+  bind_inputsSim(n == 0 ? NULL : objectGroupPointer->storage_inputsSim(indexInGroup), n);
+}
+void abstractObject::allocate_outputs(const unsigned int n) {
+  bind_outputs(n == 0 ? NULL : objectGroupPointer->storage_outputs(indexInGroup), n);
+}
+void abstractObject::bind_paramsNum(double* p, const unsigned int n) {
+  paramsNumPtr= p;
+  nParamsNum= n;
+}
+void abstractObject::bind_inputsSim(const double** p, const unsigned int n) {
+  inputsSimPtr= p;
+  nInputsSim= n;
+}
+void abstractObject::bind_outputs(double* p, const unsigned int n) {
+  outputsPtr= p;
+  nOutputs= n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Error handlers of the data access methods (see header)
+////////////////////////////////////////////////////////////////////////////////
+void abstractObject::error_indexRange(const char* func, const char* item,
+  const unsigned int index, const unsigned int size) const {
+  stringstream errmsg;
+  errmsg << "Attempt to access " << item << " with index " << index <<
+    " in object '" << idObject << "'. Index must be in range [0," <<
+    (static_cast<int>(size)-1) << "] for object group '" <<
+    objectGroupPointer->get_idObjectGroup() << "'.";
+  except e(func, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+void abstractObject::error_sharedParamNum(const char* func,
+  const unsigned int index) const {
+  stringstream errmsg;
+  errmsg << "Failed to return value of shared scalar parameter with index " <<
+    index << " in object '" << idObject << "'.";
+  except e(func, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+void abstractObject::error_paramFun(const char* func, const bool shared,
+  const unsigned int index, const double arg) const {
+  stringstream errmsg;
+  if (shared) {
+    errmsg << "Failed to return value of shared parameter function with index " <<
+      index << " in object '" << idObject << "' for argument " << arg << ".";
+  } else {
+    errmsg << "Cannot return value of individual parameter function with index '" <<
+      index << "' of object '" << idObject << "' (object group '" <<
+      objectGroupPointer->get_idObjectGroup() << "') for argument " <<
+      arg << ".";
+  }
+  except e(func, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+void abstractObject::error_paramRange(const char* func, const bool shared,
+  const unsigned int index, const double value, const double lower,
+  const double upper) const {
+  stringstream errmsg;
+  if (shared) {
+    errmsg << "Value " << value << " for shared scalar parameter " <<
+      objectGroupPointer->get_namesSharedParamsNum()[index];
+  } else {
+    errmsg << "Value " << value << " for individual scalar parameter " <<
+      objectGroupPointer->get_namesParamsNum()[index];
+  }
+  errmsg << " is outside range [" << lower << ", " << upper << "].";
+  except e(func, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Method to delete the external inputs (vector of vectors)
 ////////////////////////////////////////////////////////////////////////////////
@@ -85,8 +178,10 @@ const vector<abstractObject*>& abstractObject::get_backwardInputObjectPointers()
 // Set and get pointer to object group
 ////////////////////////////////////////////////////////////////////////////////
 
-void abstractObject::set_objectGroupPointer (abstractObjectGroup* p) {
+void abstractObject::set_objectGroupPointer (abstractObjectGroup* p,
+  const unsigned int index) {
   objectGroupPointer= p;
+  indexInGroup= index;
 }
 
 abstractObjectGroup* abstractObject::get_objectGroupPointer() const {
@@ -133,20 +228,34 @@ void abstractObject::set_debugMode(const table &tab) {
 ////////////////////////////////////////////////////////////////////////////////
 
 const double* abstractObject::get_outputAddress(const unsigned int index) const {
-  if (outputs.size() == 0) {
+  if (nOutputs == 0) {
     except e(__PRETTY_FUNCTION__, "Vector(s) of object outputs not yet allocated.", __FILE__, __LINE__);
     throw(e);
   }
-  if (index >= outputs.size()) {
+  if (index >= nOutputs) {
     stringstream errmsg;
     errmsg << "Cannot return address of output with index " << index <<
       " for object '" << idObject << "' which belongs to group '" <<
       objectGroupPointer->get_idObjectGroup() << "'. Index must be in" <<
-      " range [0," << (outputs.size()-1) << "].";
+      " range [0," << (nOutputs-1) << "].";
     except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
     throw(e);
   }
-  return(&outputs[index]);
+  return(&outputsPtr[index]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the number of elements of a vector state variable
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int abstractObject::get_stateVectSize(const unsigned int index) const {
+  return(statesVect.read_access(index).size());
+}
+unsigned int abstractObject::get_statesVectSize() const {
+  return(statesVect.size());
+}
+void abstractObject::bind_statesVect(double* p) {
+  statesVect.bind(p);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,9 +271,9 @@ void abstractObject::init_outputs(const table &tab) {
   try {
     // Allocate vector of object outputs
     const vector<string>& names= objectGroupPointer->get_namesOutputs();
-    outputs.resize(names.size());
+    allocate_outputs(names.size());
     // Initialize vector holding the indices of the outputs to be printed
-    if (outputs.size() > 0) {
+    if (nOutputs > 0) {
       try {
         colindex_idObj= tab.colindex(globalConst::colNames.objectID);
         colindex_idVar= tab.colindex(globalConst::colNames.variableName);
@@ -230,20 +339,28 @@ void abstractObject::init_paramsFun(const string chars_colsep, const string char
   unsigned int colindex_file;
   unsigned int colindex_arg;
   unsigned int colindex_val;
+  unsigned int colindex_interp= 0;
   string colname_inFile_arg;
   string colname_inFile_val;
   string file;
-  table tab_thisObject;
-  vector<table::size_type> rownums_object;
+  tblFunction::T_interpolation method;
+  vector<table::size_type> colindices_search(2);
+  vector<string> searchstrings(2);
   vector<table::size_type> rownums_funct;
   // Get function names and allocate functions
   const vector<string>& namesParamsFun= objectGroupPointer->get_namesParamsFun();
   paramsFun.resize(namesParamsFun.size());
+  // Set lookup cursors for individual and shared functions
+  nSharedParamsFun= objectGroupPointer->get_namesSharedParamsFun().size();
+  paramsFunCursors= objectGroupPointer->storage_paramsFunCursors(indexInGroup);
+  sharedParamsFunCursors= objectGroupPointer->storage_sharedParamsFunCursors(indexInGroup);
+  fill(paramsFunCursors, paramsFunCursors + namesParamsFun.size(), 0);
+  fill(sharedParamsFunCursors, sharedParamsFunCursors + nSharedParamsFun, 0);
   // Set functions
   if (paramsFun.size() > 0) {
+    // Get table for the object group
+    const table &tab_allObjects= objectGroupPointer->get_tableParamsFun();
     try {
-      // Get table for the object group
-      const table &tab_allObjects= objectGroupPointer->get_tableParamsFun();
       // Check column names
       try {
         colindex_idObject= tab_allObjects.colindex(globalConst::colNames.objectID);
@@ -251,6 +368,9 @@ void abstractObject::init_paramsFun(const string chars_colsep, const string char
         colindex_file= tab_allObjects.colindex(globalConst::colNames.fileName);
         colindex_arg= tab_allObjects.colindex(globalConst::colNames.argumentColumnName);
         colindex_val= tab_allObjects.colindex(globalConst::colNames.valueColumnName);
+        // Optional column (linear interpolation if missing)
+        if (tab_allObjects.has_col(globalConst::colNames.interpolation))
+          colindex_interp= tab_allObjects.colindex(globalConst::colNames.interpolation);
       } catch (except) {
         stringstream errmsg;
         errmsg << "Could not initialize parameter function(s) for object with" <<
@@ -265,19 +385,6 @@ void abstractObject::init_paramsFun(const string chars_colsep, const string char
         except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
         throw(e);
       }
-      // Filter records using the object id
-      try {
-        tab_allObjects.which_rows(colindex_idObject,idObject,rownums_object);
-        tab_allObjects.subset(rownums_object, tab_thisObject);
-      } catch (except) {
-        stringstream errmsg;
-        errmsg << "Could not initialize parameter function(s) for object with" <<
-          " id '" << idObject << "'. Subsetting of the table of parameter" <<
-          " functions for object group '" << objectGroupPointer->get_idObjectGroup() <<
-          "' using the object id failed.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
     } catch (except) {
       stringstream errmsg;
       errmsg << "Could not initialize parameter function(s) for object with" <<
@@ -286,22 +393,15 @@ void abstractObject::init_paramsFun(const string chars_colsep, const string char
       except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
       throw(e);
     }
-    // Select the search column in the subset
-    try {
-      tab_thisObject.update_searchcolumn(colindex_idFunction);
-    } catch (except) {
-      stringstream errmsg;
-      errmsg << "Could not initialize parameter function(s) for object with" <<
-        " id '" << idObject << "'. Could not select the column containing the" <<
-        " function name in the table of parameter functions for object group '" <<
-        objectGroupPointer->get_idObjectGroup() << "'.";
-      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-      throw(e);
-    }
+    // Records are searched by object id and function name
+    colindices_search[0]= colindex_idObject;
+    colindices_search[1]= colindex_idFunction;
+    searchstrings[0]= idObject;
     for (unsigned int i=0; i<paramsFun.size(); i++) {
       // Find record with function definition using the function's name
       try {
-        tab_thisObject.which_rows(colindex_idFunction, namesParamsFun[i], rownums_funct);
+        searchstrings[1]= namesParamsFun[i];
+        tab_allObjects.which_rows(colindices_search, searchstrings, rownums_funct);
         if (rownums_funct.size() != 1) {
           stringstream errmsg;
           errmsg << "Number of matching records for parameter function '" << 
@@ -324,9 +424,13 @@ void abstractObject::init_paramsFun(const string chars_colsep, const string char
       }
       // Get file name, and names of argument and value columns
       try {
-        file= tab_thisObject.get_element(rownums_funct[0], colindex_file);
-        colname_inFile_arg= tab_thisObject.get_element(rownums_funct[0], colindex_arg);
-        colname_inFile_val= tab_thisObject.get_element(rownums_funct[0], colindex_val);
+        file= tab_allObjects.get_element(rownums_funct[0], colindex_file);
+        colname_inFile_arg= tab_allObjects.get_element(rownums_funct[0], colindex_arg);
+        colname_inFile_val= tab_allObjects.get_element(rownums_funct[0], colindex_val);
+        method= tblFunction::linear;
+        if (colindex_interp > 0)
+          method= tblFunction::interpolation_method(
+            tab_allObjects.get_element(rownums_funct[0], colindex_interp));
       } catch (except) {
         stringstream errmsg;
         errmsg << "Could not initialize parameter function '" << 
@@ -339,7 +443,7 @@ void abstractObject::init_paramsFun(const string chars_colsep, const string char
       // Read the function data
       try {
         paramsFun[i].read(file, true, chars_colsep, chars_comment,
-          namesParamsFun[i], colname_inFile_arg, colname_inFile_val);
+          namesParamsFun[i], colname_inFile_arg, colname_inFile_val, method);
       } catch (except) {
         stringstream errmsg;
         errmsg << "Could not initialize parameter function '" << 
@@ -363,9 +467,9 @@ void abstractObject::init_paramsNum() {
   table::size_type rowindex_object;
   // Get parameter names and allocate parameters
   const vector<string>& namesParamsNum= objectGroupPointer->get_namesParamsNum();
-  paramsNum.resize(namesParamsNum.size());
+  allocate_paramsNum(namesParamsNum.size());
   // Set parameters
-  if (paramsNum.size() > 0) {
+  if (nParamsNum > 0) {
     try {
       // Get table for the object group and filter records using the object id
       const table &tab= objectGroupPointer->get_tableParamsNum();
@@ -389,7 +493,7 @@ void abstractObject::init_paramsNum() {
         throw(e);
       }
       // Loop through parameters
-      for (unsigned int i=0; i<paramsNum.size(); i++) {
+      for (unsigned int i=0; i<nParamsNum; i++) {
         // Find column
         try {
           colindex_param= tab.colindex(namesParamsNum[i]);
@@ -403,7 +507,7 @@ void abstractObject::init_paramsNum() {
         }
         // Assign value
         try {
-          paramsNum[i]= as_double(tab.get_element(rowindex_object, colindex_param));
+          paramsNumPtr[i]= as_double(tab.get_element(rowindex_object, colindex_param));
         } catch (except) {
           stringstream errmsg;
           errmsg << "Could not set value of parameter '" << namesParamsNum[i] <<
@@ -425,28 +529,44 @@ void abstractObject::init_paramsNum() {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Replace individual scalar parameters
+////////////////////////////////////////////////////////////////////////////////
+
+void abstractObject::set_paramsNum(const vector<double> &values) {
+  if (values.size() != nParamsNum) {
+    stringstream errmsg;
+    errmsg << "Cannot set " << values.size() << " value(s) of scalar parameters" <<
+      " for object with id '" << idObject << "'. Expecting " << nParamsNum <<
+      " value(s) in the order of the parameter names of object group '" <<
+      objectGroupPointer->get_idObjectGroup() << "'.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  for (unsigned int i=0; i<nParamsNum; i++) {
+    paramsNumPtr[i]= values[i];
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Set simulated inputs (linkage of objects)
 ////////////////////////////////////////////////////////////////////////////////
 
 void abstractObject::assign_inputsSim(const table &tab,
-  const vector<abstractObject*> &objects
+  const vector<abstractObject*> &objects,
+  const map<string, unsigned int> &objectIndices
 ) {
-  typedef map<string, unsigned int> name_index_map;
-  typedef pair<string, unsigned int> name_index_pair;
   table::size_type colindex_idTargetObj, colindex_idSourceObj,
     colindex_idTargetVar, colindex_idSourceVar, colindex_forwardType;
   vector<table::size_type> rowinds_object;
   vector<string>::const_iterator iter;
   vector<string>::difference_type pos_targetVar, pos_sourceVar;
   unsigned int pos_sourceObj;
-  static name_index_map id2indexMap;
-  static bool id2indexMap_isInitialized=false;
   bool forwardType;
   try {
     // Allocate simulated inputs
     const vector<string>& namesInputsSim= objectGroupPointer->get_namesInputsSim();
-    inputsSim.resize(namesInputsSim.size());
+    allocate_inputsSim(namesInputsSim.size());
     if (namesInputsSim.size() > 0) {
       // Determine position of required columns in table
       try {
@@ -499,24 +619,10 @@ void abstractObject::assign_inputsSim(const table &tab,
         }
         pos_targetVar= distance(namesInputsSim.begin(), iter);
         // Determine index of the source object and check that it is not identical
-        // with the target object (loop). To speed up the lookup of the object index
-        // a map is used which is initialized on the first call of this function.
-        // We rely on (and this seems legitimate) that the order of the objects in
-        // the objects vector does not change between function calls.
-        if (!id2indexMap_isInitialized) {
-          pair<name_index_map::const_iterator, bool> insert_status;
-          for (unsigned int k=0; k<objects.size(); k++) {
-            insert_status= id2indexMap.insert(name_index_pair(objects[k]->get_idObject(),k));
-            if (!insert_status.second) {
-              except e(__PRETTY_FUNCTION__, "Cannot create map of object IDs.", __FILE__, __LINE__);
-              throw(e);
-            }
-          }
-          id2indexMap_isInitialized= true;
-        }
-        name_index_map::const_iterator id2indexMap_iter= id2indexMap.find(
+        // with the target object (loop)
+        map<string, unsigned int>::const_iterator id2indexMap_iter= objectIndices.find(
           tab.get_element(rowinds_object[i], colindex_idSourceObj));
-        if (id2indexMap_iter == id2indexMap.end()) {
+        if (id2indexMap_iter == objectIndices.end()) {
           stringstream errmsg;
           errmsg << "Error in object linkage table at record " <<
             rowinds_object[i] << ". Cannot determine index of object with ID '" <<
@@ -628,7 +734,7 @@ void abstractObject::assign_inputsSim(const table &tab,
         pos_sourceVar= distance(namesOutputs.begin(), iter);
         // Establish the link between the target variable of this object and
         // the source variable of the source object (by setting the pointer)
-        inputsSim[pos_targetVar]= objects[pos_sourceObj]->get_outputAddress(pos_sourceVar);
+        inputsSimPtr[pos_targetVar]= objects[pos_sourceObj]->get_outputAddress(pos_sourceVar);
       } // End of loop over simulated inputs
     }
   } catch (except) {
@@ -857,7 +963,8 @@ void abstractObject::init_statesScal(const table &tab) {
 void abstractObject::init_statesVect(const table &tab) {
   table::size_type colindex_idObj, colindex_idVar, colindex_index, colindex_value;
   vector<table::size_type> rowinds;
-  table tab_subset;
+  vector<table::size_type> colindices_search(2);
+  vector<string> searchstrings(2);
   vector<double> tmp;
   unsigned int index;
   try {
@@ -895,13 +1002,14 @@ void abstractObject::init_statesVect(const table &tab) {
         except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
         throw(e);
       }
-      // Save subset as table
-		  tab.subset(rowinds, tab_subset);
-      // Select search column in the subset
-      tab_subset.update_searchcolumn(colindex_idVar);  // Can't fail as index was already checked
+      // Records are searched by object id and variable name
+      colindices_search[0]= colindex_idObj;
+      colindices_search[1]= colindex_idVar;
+      searchstrings[0]= idObject;
       // Loop through state variables and filter for them
       for (unsigned int i=0; i<namesStatesVect.size(); i++) {
-        tab_subset.which_rows(colindex_idVar, namesStatesVect[i], rowinds);
+        searchstrings[1]= namesStatesVect[i];
+        tab.which_rows(colindices_search, searchstrings, rowinds);
         if (rowinds.size() == 0) {
           stringstream errmsg;
           errmsg << "Missing initialization data for vector state variable '" <<
@@ -916,7 +1024,7 @@ void abstractObject::init_statesVect(const table &tab) {
         tmp.resize(rowinds.size());
         for (unsigned int k=0; k<rowinds.size(); k++) {
           try {
-            index= as_unsigned_integer(tab_subset.get_element(rowinds[k], colindex_index));
+            index= as_unsigned_integer(tab.get_element(rowinds[k], colindex_index));
           } catch (except) {
             stringstream errmsg;
             errmsg << "Invalid index detected for vector state variable '" <<
@@ -936,7 +1044,7 @@ void abstractObject::init_statesVect(const table &tab) {
             throw(e);
           }
           try {
-            tmp[k]= as_double(tab_subset.get_element(rowinds[k], colindex_value));
+            tmp[k]= as_double(tab.get_element(rowinds[k], colindex_value));
           } catch (except) {
             stringstream errmsg;
             errmsg << "Error in table of vector state variables' initial values." <<
@@ -951,7 +1059,6 @@ void abstractObject::init_statesVect(const table &tab) {
         statesVect.add(tmp);        
         tmp.clear();
       } // End of loop over state variables
-      tab_subset.clear();
     }
   } catch (except) {
     stringstream errmsg;
@@ -962,11 +1069,57 @@ void abstractObject::init_statesVect(const table &tab) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Names of the output files and check for existing files
+////////////////////////////////////////////////////////////////////////////////
+
+string abstractObject::file_selected(const string &outdir, const string &outfmt) const {
+  if (outfmt == "tab") {
+    return(outdir + "/" + idObject + globalConst::fileExtensions.tabular);
+  } else if (outfmt == "json") {
+    return(outdir + "/" + idObject + globalConst::fileExtensions.json);
+  } else {
+    stringstream errmsg;
+    errmsg << "Requested output file format '" << outfmt <<
+      "' is unknown. Currently supported formats are 'tab' for" <<
+      " TAB-separated text or 'json' for Java-Script Object Notation.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+}
+
+string abstractObject::file_debug(const string &outdir) const {
+  return(outdir + "/" + idObject + globalConst::fileExtensions.debug);
+}
+
+void abstractObject::check_outputFiles(const string &outdir, const string &outfmt) const {
+  if (selectedOutputIndices.size() > 0) {
+    const string file= file_selected(outdir, outfmt);
+    if (file_exists(file)) {
+      stringstream errmsg;
+      errmsg << "Cannot print selected output for object '" << idObject <<
+        "' to file '" << file << "'. File already exists.";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+  }
+  if (debugMode) {
+    const string file= file_debug(outdir);
+    if (file_exists(file)) {
+      stringstream errmsg;
+      errmsg << "Cannot print debug output for object '" << idObject <<
+        "' to file '" << file << "'. File already exists.";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Print selected output
 ////////////////////////////////////////////////////////////////////////////////
 
-void abstractObject::output_selected(const bool firstCall, const bool finalCall,
+void abstractObject::output_selected(const bool firstCall,
   const string &outdir, const string &outfmt,
   const string chars_colsep, const string &timestamp,
   const unsigned int timestep
@@ -978,19 +1131,7 @@ void abstractObject::output_selected(const bool firstCall, const bool finalCall,
     // On first use
     if (firstCall) {
       // Build file name and check existance
-      string file;
-      if (outfmt == "tab") {
-         file= outdir + "/" + idObject + globalConst::fileExtensions.tabular;
-      } else if (outfmt == "json") {
-         file= outdir + "/" + idObject + globalConst::fileExtensions.json;
-      } else {
-        stringstream errmsg;
-        errmsg << "Requested output file format '" << outfmt <<
-	  "' is unknown. Currently supported formats are 'tab' for" <<
-          " TAB-separated text or 'json' for Java-Script Object Notation.";
-	except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-	throw(e);
-      }
+      const string file= file_selected(outdir, outfmt);
       if (file_exists(file)) {
         stringstream errmsg;
         errmsg << "Cannot print selected output for object '" << idObject <<
@@ -1052,10 +1193,10 @@ void abstractObject::output_selected(const bool firstCall, const bool finalCall,
       if (nItems > 1) {
 	for (vector<double>::size_type i=0; i<(nItems-1); i++) *osPtrSel <<
 	  std::fixed << std::setprecision(selectedOutputDigits[i]) <<
-	  outputs[selectedOutputIndices[i]] << chars_colsep;
+	  outputsPtr[selectedOutputIndices[i]] << chars_colsep;
       }
       *osPtrSel << std::fixed << std::setprecision(selectedOutputDigits[nItems-1]) <<
-	 outputs[selectedOutputIndices[nItems-1]];
+	 outputsPtr[selectedOutputIndices[nItems-1]];
       *osPtrSel << endl;
     } else if (outfmt == "json") {
       if (!firstCall)
@@ -1063,12 +1204,10 @@ void abstractObject::output_selected(const bool firstCall, const bool finalCall,
       if (nItems > 1) {
 	for (vector<double>::size_type i=0; i<(nItems-1); i++) *osPtrSel <<
 	  std::fixed << std::setprecision(selectedOutputDigits[i]) <<
-	  outputs[selectedOutputIndices[i]] << ",";
+	  outputsPtr[selectedOutputIndices[i]] << ",";
       }
       *osPtrSel << std::fixed << std::setprecision(selectedOutputDigits[nItems-1]) <<
-	 outputs[selectedOutputIndices[nItems-1]];
-      if (finalCall)
-        *osPtrSel << endl << "]" << endl << "}" << endl;
+	 outputsPtr[selectedOutputIndices[nItems-1]];
     } else {
       stringstream errmsg;
       errmsg << "Output format not supported. Please report this bug!";
@@ -1090,7 +1229,7 @@ void abstractObject::output_debug(const bool firstCall, const string &outdir,
     // On first use
     if (firstCall) {
       // Build file name and check existance
-      string file= outdir + "/" + idObject + globalConst::fileExtensions.debug;
+      const string file= file_debug(outdir);
       if (file_exists(file)) {
         stringstream errmsg;
         errmsg << "Cannot print debug output for object '" << idObject <<
@@ -1144,7 +1283,7 @@ void abstractObject::output_debug(const bool firstCall, const string &outdir,
       const vector<string>& names= objectGroupPointer->get_namesStatesVect();
       if (names.size() > 0) {
         for (vector<string>::size_type i=0; i<names.size(); i++) {
-          const vector<double>& values= statesVect.read_access(i);
+          vectorView<const double> values= statesVect.read_access(i);
           for (vector<string>::size_type k=0; k<values.size(); k++) {
             *osPtrDbg << timestamp << chars_colsep << "stateVect" << chars_colsep <<
               names[i] << chars_colsep << k << chars_colsep <<
@@ -1188,7 +1327,7 @@ void abstractObject::output_debug(const bool firstCall, const string &outdir,
         for (vector<string>::size_type i=0; i<names.size(); i++) {
           *osPtrDbg << timestamp << chars_colsep << "inputSim" << chars_colsep <<
             names[i] << chars_colsep << "0" << chars_colsep << 
-            scientific << setprecision(3) << *inputsSim[i] << endl;
+            scientific << setprecision(3) << *inputsSimPtr[i] << endl;
         }
       }
     } catch (except) {
@@ -1205,7 +1344,7 @@ void abstractObject::output_debug(const bool firstCall, const string &outdir,
         for (vector<string>::size_type i=0; i<names.size(); i++) {
           *osPtrDbg << timestamp << chars_colsep << "output" << chars_colsep <<
             names[i] << chars_colsep << "0" << chars_colsep << 
-            scientific << setprecision(3) << outputs[i] << endl;
+            scientific << setprecision(3) << outputsPtr[i] << endl;
         }
       }
     } catch (except) {
@@ -1219,6 +1358,18 @@ void abstractObject::output_debug(const bool firstCall, const string &outdir,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Method to complete the file of selected output after the last time step
+////////////////////////////////////////////////////////////////////////////////
+
+void abstractObject::finishOutput_selected(const string &outfmt) {
+  if (osPtrSel && osPtrSel->is_open()) {
+    if (outfmt == "json") {
+      *osPtrSel << endl << "]" << endl << "}" << endl;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Methods to explicitly close the output files
 ////////////////////////////////////////////////////////////////////////////////
@@ -1238,6 +1389,31 @@ void abstractObject::closeOutput_debug() {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Dynamic data for binary checkpoints
+////////////////////////////////////////////////////////////////////////////////
+void abstractObject::checkpoint_sizes(unsigned int &nStatesScal,
+  unsigned int &nStatesVect, unsigned int &nOutputs) const {
+  nStatesScal= statesScal.size();
+  nStatesVect= statesVect.size();
+  nOutputs= this->nOutputs;
+}
+unsigned int abstractObject::checkpoint_size() const {
+  return(statesScal.size() + statesVect.size() + nOutputs);
+}
+void abstractObject::checkpoint_save(double* dest) const {
+  dest= copy(statesScal.begin(), statesScal.end(), dest);
+  dest= copy(statesVect.data(), statesVect.data() + statesVect.size(), dest);
+  copy(outputsPtr, outputsPtr + nOutputs, dest);
+}
+void abstractObject::checkpoint_restore(const double* src) {
+  copy(src, src + statesScal.size(), statesScal.begin());
+  src+= statesScal.size();
+  copy(src, src + statesVect.size(), statesVect.data());
+  src+= statesVect.size();
+  copy(src, src + nOutputs, outputsPtr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Method to check an object for invalid numerical values
 ////////////////////////////////////////////////////////////////////////////////
@@ -1263,7 +1439,7 @@ void abstractObject::checkFPE() const {
   n= statesVect.nvars();
   if (n > 0) {
     for (unsigned int i=0; i<n; i++) {
-      const vector<double>& v= statesVect.read_access(i);
+      vectorView<const double> v= statesVect.read_access(i);
       for (unsigned int k=0; k<v.size(); k++) {
         if (!isfinite(v[k])) {
           stringstream errmsg;
@@ -1278,10 +1454,10 @@ void abstractObject::checkFPE() const {
     }
   }
   // Output variables
-  n= outputs.size();
+  n= nOutputs;
   if (n > 0) {
     for (unsigned int i=0; i<n; i++) {	
-      if (!isfinite(outputs[i])) {
+      if (!isfinite(outputsPtr[i])) {
         stringstream errmsg;
         errmsg << "Invalid numerical value detected for output variable '" <<
            get_objectGroupPointer()->get_namesOutputs()[i] << "' of object '" <<
@@ -1302,3 +1478,34 @@ void abstractObject::checkFPE() const {
   }
 }	
 
+////////////////////////////////////////////////////////////////////////////////
+// Method to test an object for invalid numerical values (no exception)
+////////////////////////////////////////////////////////////////////////////////
+bool abstractObject::isFinite(string &nameInvalid) const {
+  // Scalar state variables
+  for (unsigned int i=0; i<statesScal.size(); i++) {
+    if (!isfinite(statesScal[i])) {
+      nameInvalid= get_objectGroupPointer()->get_namesStatesScal()[i];
+      return(false);
+    }
+  }
+  // Vector state variables
+  for (unsigned int i=0; i<statesVect.nvars(); i++) {
+    vectorView<const double> v= statesVect.read_access(i);
+    for (unsigned int k=0; k<v.size(); k++) {
+      if (!isfinite(v[k])) {
+        nameInvalid= get_objectGroupPointer()->get_namesStatesVect()[i];
+        return(false);
+      }
+    }
+  }
+  // Output variables
+  for (unsigned int i=0; i<nOutputs; i++) {
+    if (!isfinite(outputsPtr[i])) {
+      nameInvalid= get_objectGroupPointer()->get_namesOutputs()[i];
+      return(false);
+    }
+  }
+  return(true);
+}
+
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
 #include <algorithm>
 #include <cmath>
 
@@ -22,10 +23,6 @@
 #include "echse_options.h"
 #include "echse_globalConst.h"
 
-#ifndef CHECK_RANGE
-#  error "Macro CHECK_RANGE is undefined."
-#endif
-
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +34,9 @@ using namespace std;
 // another vector). Note that this cannot be achieved by 'typedef' because the
 // types created by 'typedef' are 'transparent', i.e. they are interchangeable
 // if they point to the same base type (like unsigned int, for example).
+// The index types are literal types, hence index constants can be declared as
+// 'constexpr' (e.g. 'constexpr T_index_output q= {0};'), which allows for
+// constant offsets in classes derived from 'sizedObject'.
 ////////////////////////////////////////////////////////////////////////////////
 
 struct T_index_stateScal { unsigned int index; };
@@ -54,6 +54,9 @@ struct T_index_output { unsigned int index; };
 ////////////////////////////////////////////////////////////////////////////////
 
 class abstractObject {
+  // The data access methods are defined in a class template with a checked and
+  // an unchecked variant (see 'echse_coreClass_objectAccess.h')
+  template<bool CHECKED> friend class objectAccess;
   private:
     // Type for external inputs
     struct weightedValue {
@@ -65,16 +68,32 @@ class abstractObject {
     // Object level: This is an index which may be shared by a group of objects.
     //              Objects which share the same level can be simulated in parallel.
     unsigned int objectLevel;
-    // Pointer to object group
+    // Pointer to object group and position of the object in the group
     abstractObjectGroup* objectGroupPointer;
+    unsigned int indexInGroup;
     // Object inputs, states, and outputs
-    vector<double> paramsNum;
     vector<tblFunction> paramsFun;
     vector< vector<weightedValue> > inputsExt;
-    vector<const double*> inputsSim;
     vector<double> statesScal;
     multiState statesVect;
-    vector<double> outputs;
+    // Lookup cursors for individual and shared parameter functions (held in
+    // the storage of the object group)
+    tblFunction::size_type* paramsFunCursors;
+    tblFunction::size_type* sharedParamsFunCursors;
+    unsigned int nSharedParamsFun;
+    // Storage actually in use for individual scalar parameters, simulated
+    // inputs, and outputs together with the number of items. By default, the
+    // pointers refer to the object's slot in the storage of the object group
+    // (see 'abstractObjectGroup::storage_paramsNum' etc.). Classes derived from
+    // 'sizedObject' redirect them to arrays of their own (see the allocate_*
+    // methods). Note: The pointers are set during initialization. Objects must
+    // not be copied afterwards.
+    double* paramsNumPtr;
+    const double** inputsSimPtr;
+    double* outputsPtr;
+    unsigned int nParamsNum;
+    unsigned int nInputsSim;
+    unsigned int nOutputs;
     // Vector of input objects: Keeping this info (1) speeds up determination of
     //                         the object level and (2) allows for checking whether
     //                         the selection of objects for simulation is reasonable. 
@@ -88,57 +107,32 @@ class abstractObject {
     // Pointers to output streams
     ofstream* osPtrSel; // standard output of selected variables
     ofstream* osPtrDbg; // debug output
+    // Names of the output files
+    string file_selected(const string &outdir, const string &outfmt) const;
+    string file_debug(const string &outdir) const;
   protected:
-    // FULL access to states and outputs for use at the LEFT hand side of expressions
-    // in the simulate() method of derived classes. This is accomplished by the
-    // use of non-const references.
-    double& set_output(const T_index_output &index) {
-      #if CHECK_RANGE
-      if (index.index >= outputs.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access output variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (outputs.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(outputs[index.index]);
-    }
-    // Access to single item
-    double& set_stateScal(const T_index_stateScal &index) {
-      #if CHECK_RANGE
-      if (index.index >= statesScal.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access scalar state variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (statesScal.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(statesScal[index.index]);
-    }
-    // Access to entire vector
-    vector<double>& set_stateScal_all() {
-      return(statesScal);
-    }
-    vector<double>& set_stateVect(const T_index_stateVect &index) {
-      #if CHECK_RANGE
-      if (index.index >= statesVect.nvars()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access vector state variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (statesVect.nvars()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(statesVect.full_access(index.index));
-    }
+    // Allocation of the storage for individual scalar parameters, simulated
+    // inputs, and outputs. The default implementation uses the object's slot in
+    // the storage of the object group. Derived classes with storage of their own override these methods
+    // and call the bind_* methods instead.
+    virtual void allocate_paramsNum(const unsigned int n);
+    virtual void allocate_inputsSim(const unsigned int n);
+    virtual void allocate_outputs(const unsigned int n);
+    void bind_paramsNum(double* p, const unsigned int n);
+    void bind_inputsSim(const double** p, const unsigned int n);
+    void bind_outputs(double* p, const unsigned int n);
+    // Error handlers of the data access methods. They are defined out-of-line
+    // and marked as cold, so that the access methods remain small enough to be
+    // inlined. The error message is only formatted if an error occurs.
+    [[noreturn]] void error_indexRange(const char* func, const char* item,
+      const unsigned int index, const unsigned int size) const ECHSE_COLD;
+    [[noreturn]] void error_sharedParamNum(const char* func,
+      const unsigned int index) const ECHSE_COLD;
+    [[noreturn]] void error_paramFun(const char* func, const bool shared,
+      const unsigned int index, const double arg) const ECHSE_COLD;
+    [[noreturn]] void error_paramRange(const char* func, const bool shared,
+      const unsigned int index, const double value, const double lower,
+      const double upper) const ECHSE_COLD;
   public:
     // Constructor
     abstractObject ();
@@ -156,7 +150,7 @@ class abstractObject {
     const vector<abstractObject*>& get_forwardInputObjectPointers() const;
     const vector<abstractObject*>& get_backwardInputObjectPointers() const;
     // Set and get object group
-    void set_objectGroupPointer (abstractObjectGroup* p);
+    void set_objectGroupPointer (abstractObjectGroup* p, const unsigned int index);
     abstractObjectGroup* get_objectGroupPointer() const;
     // Set and query debug mode
     bool debugMode_isOn() const;
@@ -166,224 +160,61 @@ class abstractObject {
     // Set parameters
     void init_paramsFun(const string chars_colsep, const string chars_comment);
     void init_paramsNum();
+    // Replace the values of all individual scalar parameters (after init_paramsNum)
+    void set_paramsNum(const vector<double> &values);
     // Initialize state variables
     void init_statesScal(const table &tab);
     void init_statesVect(const table &tab);
     // Get the address of a object output
     const double* get_outputAddress(const unsigned int index) const;
-    // Set simulated inputs (internal boundary conditions)
-    void assign_inputsSim(const table &tab, const vector<abstractObject*> &objects);
+    // Get the number of elements of a vector state variable
+    unsigned int get_stateVectSize(const unsigned int index) const;
+    // Get the number of elements of all vector state variables together and
+    // move their values to external storage of that size (see
+    // 'abstractObjectGroup::store_statesVect')
+    unsigned int get_statesVectSize() const;
+    void bind_statesVect(double* p);
+    // Set simulated inputs (internal boundary conditions). The map holds the
+    // position of each object in 'objects' (key: object ID).
+    void assign_inputsSim(const table &tab, const vector<abstractObject*> &objects,
+      const map<string, unsigned int> &objectIndices);
     // Set external inputs (external boundary conditions)
     void assign_inputsExt(const table &tab, const spaceTimeDataCollection &externalInputs);
     // Printing of output
-    void output_selected(const bool firstCall, const bool finalCall, const string &outdir,
+    void output_selected(const bool firstCall, const string &outdir,
       const string &outfmt, const string chars_colsep, const string &timestamp, const unsigned int timestep);
     void output_debug(const bool firstCall, const string &outdir,
       const string chars_colsep, const string &timestamp);
+    // Throw an exception if a file of selected or debug output of the object
+    // already exists in the output directory
+    void check_outputFiles(const string &outdir, const string &outfmt) const;
+    // Complete the file of selected output (if open) after the last time step
+    // of a run, e.g. print the closing brackets of the json format. Must be
+    // called before 'closeOutput_selected'.
+    void finishOutput_selected(const string &outfmt);
     // Explicit closing out output files
     void closeOutput_selected();
     void closeOutput_debug();
-    // READ-ONLY access to parameters, states, inputs, and outputs for use at
-    // the RIGHT hand side of expressions in the simulate() method of derived classes.
-    // Scalar numbers and function results are returned by value, vectors as const references.
-    // Individual
-    double paramNum(const T_index_paramNum &index) const {
-      #if CHECK_RANGE
-      if (index.index >= paramsNum.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access individual scalar parameter with index " <<
-          index.index << " in object '" << idObject << "'. Index must be in range [0," <<
-          (paramsNum.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(paramsNum[index.index]);
-    }
-    // Shared
-    double sharedParamNum(const T_index_sharedParamNum &index) const {
-      try {
-        return( objectGroupPointer->get_sharedParamNum(index.index) );
-      } catch (except) {
-        stringstream errmsg;
-        errmsg << "Failed to return value of shared scalar parameter with index " <<
-          index.index << " in object '" << idObject << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-    }
-    // Individual
-    double paramFun(const T_index_paramFun &index, const double &arg) {
-      // Note: Can't be const due to lookup index update
-      #if CHECK_RANGE
-      if (index.index >= paramsFun.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access individual parameter function with index " <<
-          index.index << " in object '" << idObject << "'. Index must be in range [0," <<
-          (paramsFun.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      try {
-        return(paramsFun[index.index].eval(arg));
-      } catch (except) {
-        stringstream errmsg;
-        errmsg << "Cannot return value of individual parameter function with index '" <<
-          index.index << "' of object '" << idObject << "' (object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "') for argument " <<
-          arg << ".";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-    }
-    // Shared
-    double sharedParamFun(const T_index_sharedParamFun &index, const double &arg) {
-      // Note: Can't be const due to lookup index update
-      try {
-        return( objectGroupPointer->get_sharedParamFun(index.index,arg) );
-      } catch (except) {
-        stringstream errmsg;
-        errmsg << "Failed to return value of shared parameter function with index " <<
-          index.index << "in object '" << idObject << "' for argument " << arg << ".";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-    }
-    double inputExt(const T_index_inputExt &index) const {
-      double result;
-      #if CHECK_RANGE
-      if (index.index >= inputsExt.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access external input variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (inputsExt.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      result= 0.;
-      for (unsigned int i=0; i<inputsExt[index.index].size(); i++) {
-        result= result + (*inputsExt[index.index][i].valPtr) * inputsExt[index.index][i].weight;
-      }
-      return(result);
-    }
-    double inputSim(const T_index_inputSim &index) const {
-      #if CHECK_RANGE
-      if (index.index >= inputsSim.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access simulated input variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (inputsSim.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(*inputsSim[index.index]);
-    }
-    // Single item
-    double stateScal(const T_index_stateScal &index) const {
-      #if CHECK_RANGE
-      if (index.index >= statesScal.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access scalar state variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (statesScal.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(statesScal[index.index]);
-    }
-    // Entire vector
-    const vector<double>& stateScal_all() const {
-      return(statesScal);
-    }
-    const vector<double>& stateVect(const T_index_stateVect &index) const {
-      #if CHECK_RANGE
-      if (index.index >= statesVect.nvars()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access vector state variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (statesVect.nvars()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(statesVect.read_access(index.index));
-    }
-    double output(const T_index_output &index) const {
-      #if CHECK_RANGE
-      if (index.index >= outputs.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access output variable with index " << index.index <<
-          " in object '" << idObject << "'. Index must be in range [0," <<
-          (outputs.size()-1) << "] for object group '" <<
-          objectGroupPointer->get_idObjectGroup() << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
-      return(outputs[index.index]);
-    }
     // Check states and outputs for floating point exceptions
     void checkFPE() const;
+    // Like 'checkFPE' but without exceptions: Returns false and the name of the
+    // first invalid variable if a state or output is not finite
+    bool isFinite(string &nameInvalid) const;
+    // Dynamic data of the object for binary checkpoints (see
+    // 'echse_coreFunct_checkpoint.h'): Values of the scalar states, the vector
+    // states, and the outputs (the latter are required since objects may read
+    // outputs of downstream objects computed in the previous time step).
+    // The data are copied to/from an array holding checkpoint_size() values.
+    void checkpoint_sizes(unsigned int &nStatesScal, unsigned int &nStatesVect,
+      unsigned int &nOutputs) const;
+    unsigned int checkpoint_size() const;
+    void checkpoint_save(double* dest) const;
+    void checkpoint_restore(const double* src);
     // Virtual methods defined in the derived classes
     virtual void simulate(const unsigned int delta_t)= 0;
     virtual void derivsScal(const double t, const vector<double> &u,
       vector<double> &dudt, const unsigned int delta_t)= 0;
 
-    // Checks whether scalar parameters are within range [lower, upper]
-    void checkParamNum (const T_index_paramNum &index,
-      const double lower, const double upper) {
-      double value;
-      string name;
-      try {
-        value= paramNum(index);
-        name= objectGroupPointer->get_namesParamsNum()[index.index];
-      } catch (except) {
-        stringstream errmsg;
-        errmsg << "Failed to access individual scalar parameter with index " <<
-          index.index << " in object '" << idObject << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      if ((value < lower) || (value > upper)) {
-        stringstream errmsg;
-        errmsg << "Value " << value << " for individual scalar parameter " <<
-          name << " is outside range [" << lower << ", " << upper << "].";
-        except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-        throw(e);
-      }
-    }
-    void checkSharedParamNum (const T_index_sharedParamNum &index,
-      const double lower, const double upper) {
-      double value;
-      string name;
-      try {
-        value= sharedParamNum(index);
-        name= objectGroupPointer->get_namesSharedParamsNum()[index.index];
-      } catch (except) {
-        stringstream errmsg;
-        errmsg << "Failed to access shared scalar parameter with index " <<
-          index.index << " in object '" << idObject << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      if ((value < lower) || (value > upper)) {
-        stringstream errmsg;
-        errmsg << "Value " << value << " for shared scalar parameter " <<
-          name << " is outside range [" << lower << ", " << upper << "].";
-        except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-        throw(e);
-      }
-    }
 
 };
 
@@ -1,11 +1,20 @@
 
 #include "echse_coreClass_abstractObjectGroup.h"
+#include "echse_coreClass_abstractObject.h"
+
+// Initialization of static members
+unsigned int abstractObjectGroup::maxInstances= 1;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor
 ////////////////////////////////////////////////////////////////////////////////
 
-abstractObjectGroup::abstractObjectGroup () { }
+abstractObjectGroup::abstractObjectGroup () :
+  storage_values_ready(false), storage_pointers_ready(false),
+  storage_cursors_ready(false)
+{
+  storage_nObjects= 0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 // Destructor
@@ -31,16 +40,145 @@ abstractObjectGroup::~abstractObjectGroup () {
   mapOutputs.clear();
   mapSharedParamsFun.clear();
   mapSharedParamsNum.clear();
-  table_paramsFun.clear();
-  table_paramsNum.clear();
+  table_paramsFun.reset();
+  table_paramsNum.reset();
   sharedParamsFun.clear();
   sharedParamsNum.clear();
+  // Storage of the per-object arrays (one block per element type)
+  vector<double>().swap(storage_values);
+  vector<const double*>().swap(storage_pointers);
+  vector<tblFunction::size_type>().swap(storage_cursors);
+  vector<double>().swap(storage_statesVect);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Methods
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// Storage of the per-object arrays of fixed size
+////////////////////////////////////////////////////////////////////////////////
+
+// Layout of the blocks (n = number of objects):
+//   storage_values:   n x [paramsNum | outputs]
+//   storage_pointers: n x [inputsSim]
+//   storage_cursors:  n x [paramsFun cursors | sharedParamsFun cursors]
+// The items of one object are adjacent, so an object's data share few cache
+// lines and neighboring objects (which are mostly simulated one after the
+// other) are adjacent as well.
+
+template <class T>
+T* abstractObjectGroup::storage_slot(const char* func, vector<T> &block,
+  atomic<bool> &ready, const size_t stride, const size_t offset,
+  const size_type indexObject)
+{
+  if (stride == 0) return(NULL);
+  // Only the first request(s) for a block enter the critical section. The
+  // release/acquire pair on the flag makes the block (and the number of
+  // objects set before) visible to the threads taking the fast path.
+  if (!ready.load(memory_order_acquire)) {
+    bool failed= false;
+    #pragma omp critical (echse_objectGroupStorage)
+    {
+      if (!ready.load(memory_order_relaxed)) {
+        // The number of objects is fixed by the first allocation
+        if (storage_nObjects == 0) storage_nObjects= numObjects();
+        try {
+          block.assign(static_cast<size_t>(storage_nObjects) * stride, T());
+          ready.store(true, memory_order_release);
+        } catch (const bad_alloc&) {
+          failed= true;
+        }
+      }
+    }
+    if (failed) {
+      stringstream errmsg;
+      errmsg << "Cannot allocate storage for the " << storage_nObjects <<
+        " object(s) of object group '" << idObjectGroup << "'.";
+      except e(func,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+  }
+  if (indexObject >= storage_nObjects) {
+    stringstream errmsg;
+    errmsg << "No storage for object with index " << indexObject <<
+      " of object group '" << idObjectGroup << "'. Storage was allocated for " <<
+      storage_nObjects << " object(s). Objects must not be added after" <<
+      " initialization has started.";
+    except e(func,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  return(block.data() + indexObject * stride + offset);
+}
+
+double* abstractObjectGroup::storage_paramsNum(const size_type indexObject) {
+  return(storage_slot(__PRETTY_FUNCTION__, storage_values, storage_values_ready,
+    namesParamsNum.size() + namesOutputs.size(), 0, indexObject));
+}
+double* abstractObjectGroup::storage_outputs(const size_type indexObject) {
+  return(storage_slot(__PRETTY_FUNCTION__, storage_values, storage_values_ready,
+    namesParamsNum.size() + namesOutputs.size(), namesParamsNum.size(), indexObject));
+}
+const double** abstractObjectGroup::storage_inputsSim(const size_type indexObject) {
+  return(storage_slot(__PRETTY_FUNCTION__, storage_pointers, storage_pointers_ready,
+    namesInputsSim.size(), 0, indexObject));
+}
+tblFunction::size_type* abstractObjectGroup::storage_paramsFunCursors(const size_type indexObject) {
+  return(storage_slot(__PRETTY_FUNCTION__, storage_cursors, storage_cursors_ready,
+    namesParamsFun.size() + namesSharedParamsFun.size(), 0, indexObject));
+}
+tblFunction::size_type* abstractObjectGroup::storage_sharedParamsFunCursors(const size_type indexObject) {
+  return(storage_slot(__PRETTY_FUNCTION__, storage_cursors, storage_cursors_ready,
+    namesParamsFun.size() + namesSharedParamsFun.size(), namesParamsFun.size(), indexObject));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Storage of the vector state variables
+////////////////////////////////////////////////////////////////////////////////
+
+void abstractObjectGroup::store_statesVect() {
+  const size_type n= numObjects();
+  vector<size_t> offsets(n+1, 0);
+  for (size_type i=0; i<n; i++) {
+    offsets[i+1]= offsets[i] + get_objectAddress(i)->get_statesVectSize();
+  }
+  try {
+    storage_statesVect.assign(offsets[n], 0.);
+  } catch (const bad_alloc&) {
+    stringstream errmsg;
+    errmsg << "Cannot allocate storage for the vector state variables of the " <<
+      n << " object(s) of object group '" << idObjectGroup << "'.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  for (size_type i=0; i<n; i++) {
+    get_objectAddress(i)->bind_statesVect(storage_statesVect.data() + offsets[i]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Error handlers of the data access methods (see header)
+////////////////////////////////////////////////////////////////////////////////
+
+void abstractObjectGroup::error_indexRange(const char* func, const char* item,
+  const unsigned int index, const unsigned int size) const {
+  stringstream errmsg;
+  errmsg << "Attempt to access " << item << " with index " << index <<
+    " of object group '" << idObjectGroup << "'. Index must be in range [0," <<
+    (static_cast<int>(size)-1) << "].";
+  except e(func, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+void abstractObjectGroup::error_sharedParamFun(const char* func,
+  const unsigned int index, const double arg) const {
+  stringstream errmsg;
+  errmsg << "Cannot return value of shared parameter function with index '" <<
+    index << "' of object group '" << idObjectGroup << "' for argument " <<
+    arg << ". The function's name is '" << namesSharedParamsFun[index] << "'.";
+  except e(func, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Set and get group ID
 ////////////////////////////////////////////////////////////////////////////////
@@ -328,7 +466,9 @@ void abstractObjectGroup::set_tableParamsFun (const string file,
   const string chars_colsep, const string chars_comment
 ) {
   try {
-    table_paramsFun.read(file, true, chars_colsep, chars_comment);
+    shared_ptr<table> tab(new table());
+    tab->read(file, true, chars_colsep, chars_comment);
+    table_paramsFun= tab;
   } catch (except) {
     stringstream errmsg;
     errmsg << "Could not read table of individual parameter functions for objects " <<
@@ -343,8 +483,9 @@ void abstractObjectGroup::set_tableParamsNum (const string file,
 ) {
   vector<string> names;
   unsigned int colindex;
+  shared_ptr<table> tab(new table());
   try {
-    table_paramsNum.read(file, true, chars_colsep, chars_comment);
+    tab->read(file, true, chars_colsep, chars_comment);
   } catch (except) {
     stringstream errmsg;
     errmsg << "Could not read table of individual scalar parameters for objects " <<
@@ -353,7 +494,7 @@ void abstractObjectGroup::set_tableParamsNum (const string file,
     throw(e);
   }
   try {
-    colindex= table_paramsNum.colindex(globalConst::colNames.objectID);
+    colindex= tab->colindex(globalConst::colNames.objectID);
   } catch (except) {
     stringstream errmsg;
     errmsg << "Missing column '" << globalConst::colNames.objectID <<
@@ -364,7 +505,7 @@ void abstractObjectGroup::set_tableParamsNum (const string file,
   }
   // Check for duplicate rows (multiple entries for the same object)
   try {
-    table_paramsNum.get_col(colindex, names);
+    tab->get_col(colindex, names);
   } catch (except) {
     stringstream errmsg;
     errmsg << "Could not retrieve object IDs from table of individual scalar parameters" <<
@@ -382,7 +523,7 @@ void abstractObjectGroup::set_tableParamsNum (const string file,
   }
   // Check for duplicate column names
   try {
-    table_paramsNum.get_colnames(names);
+    tab->get_colnames(names);
   } catch (except) {
     stringstream errmsg;
     errmsg << "Could not check column names in table of individual scalar parameters" <<
@@ -399,6 +540,15 @@ void abstractObjectGroup::set_tableParamsNum (const string file,
     except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
     throw(e);
   }
+  table_paramsNum= tab;
+}
+
+void abstractObjectGroup::set_tableParamsFun (const abstractObjectGroup &source) {
+  table_paramsFun= source.table_paramsFun;
+}
+
+void abstractObjectGroup::set_tableParamsNum (const abstractObjectGroup &source) {
+  table_paramsNum= source.table_paramsNum;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -482,6 +632,8 @@ void abstractObjectGroup::set_sharedParamsFun(const string file,
   unsigned int colindex_fil;
   unsigned int colindex_arg;
   unsigned int colindex_val;
+  unsigned int colindex_interp= 0;
+  tblFunction::T_interpolation method;
   table::size_type rowindex;
   // Allocate
   sharedParamsFun.resize(namesSharedParamsFun.size());
@@ -503,6 +655,9 @@ void abstractObjectGroup::set_sharedParamsFun(const string file,
       colindex_fil= tab.colindex(globalConst::colNames.fileName);
       colindex_arg= tab.colindex(globalConst::colNames.argumentColumnName);
       colindex_val= tab.colindex(globalConst::colNames.valueColumnName);
+      // Optional column (linear interpolation if missing)
+      if (tab.has_col(globalConst::colNames.interpolation))
+        colindex_interp= tab.colindex(globalConst::colNames.interpolation);
     } catch (except) {
       stringstream errmsg;
       errmsg << "Missing column(s) in table of shared parameter functions" <<
@@ -548,8 +703,11 @@ void abstractObjectGroup::set_sharedParamsFun(const string file,
       }
       // Try to init the current function
       try {
+        method= tblFunction::linear;
+        if (colindex_interp > 0)
+          method= tblFunction::interpolation_method(tab.get_element(rowindex, colindex_interp));
         sharedParamsFun[i].read(funcfile, true, chars_colsep, chars_comment,
-          namesSharedParamsFun[i], colname_inFile_arg, colname_inFile_val);
+          namesSharedParamsFun[i], colname_inFile_arg, colname_inFile_val, method);
       } catch (except) {
         stringstream errmsg;
         errmsg << "Could not initialize shared parameter function '" << 
@@ -565,30 +723,38 @@ void abstractObjectGroup::set_sharedParamsFun(const string file,
   }
 }
 
+void abstractObjectGroup::set_sharedParamsNum(const abstractObjectGroup &source) {
+  sharedParamsNum= source.sharedParamsNum;
+}
+
+void abstractObjectGroup::set_sharedParamsFun(const abstractObjectGroup &source) {
+  sharedParamsFun= source.sharedParamsFun;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Methods that return tables of individual parameters
 ////////////////////////////////////////////////////////////////////////////////
 
 const table & abstractObjectGroup::get_tableParamsFun() const {
-  if (table_paramsFun.empty()) {
+  if ((!table_paramsFun) || table_paramsFun->empty()) {
     stringstream errmsg;
     errmsg << "Table of individual parameter functions for objects " <<
       "of object group '" << idObjectGroup << "' is empty.";
     except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
     throw(e);
   }
-  return(table_paramsFun);
+  return(*table_paramsFun);
 }
 
 const table & abstractObjectGroup::get_tableParamsNum() const {
-  if (table_paramsNum.empty()) {
+  if ((!table_paramsNum) || table_paramsNum->empty()) {
     stringstream errmsg;
     errmsg << "Table of individual scalar parameters for objects " <<
       "of object group '" << idObjectGroup << "' is empty.";
     except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
     throw(e);
   }
-  return(table_paramsNum);
+  return(*table_paramsNum);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -596,10 +762,10 @@ const table & abstractObjectGroup::get_tableParamsNum() const {
 ////////////////////////////////////////////////////////////////////////////////
 
 void abstractObjectGroup::clear_tableParamsFun() {
-  table_paramsFun.clear();
+  table_paramsFun.reset();
 }
 
 void abstractObjectGroup::clear_tableParamsNum() {
-  table_paramsNum.clear();
+  table_paramsNum.reset();
 }
 
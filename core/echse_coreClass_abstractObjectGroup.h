@@ -6,7 +6,11 @@
 #include <sstream>
 #include <string>
 #include <sstream>
+#include <vector>
 #include <map>
+#include <new>
+#include <memory>
+#include <atomic>
 
 #include "table/table.h"
 #include "functions/functions.h"
@@ -16,10 +20,6 @@
 #include "echse_options.h"
 #include "echse_globalConst.h"
 
-#ifndef CHECK_RANGE
-#  error "Macro CHECK_RANGE is undefined."
-#endif
-
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -67,14 +67,47 @@ class abstractObjectGroup {
     name_index_map mapStatesScal;
     name_index_map mapStatesVect;
     name_index_map mapOutputs;
-    // Tables with parameters for all objects of a group
-    table table_paramsFun;
-    table table_paramsNum;
+    // Tables with parameters for all objects of a group (may be shared with the
+    // groups of other ensemble members using the same files)
+    shared_ptr<const table> table_paramsFun;
+    shared_ptr<const table> table_paramsNum;
     // Vectors of parameters of the object group
     vector<double> sharedParamsNum;
     vector<tblFunction> sharedParamsFun;
+    // Error handlers of the data access methods (out-of-line, see abstractObject)
+    [[noreturn]] void error_indexRange(const char* func, const char* item,
+      const unsigned int index, const unsigned int size) const ECHSE_COLD;
+    [[noreturn]] void error_sharedParamFun(const char* func,
+      const unsigned int index, const double arg) const ECHSE_COLD;
+    // Storage for the per-object arrays whose sizes are the same for all
+    // objects of the group (individual scalar parameters, outputs, simulated
+    // inputs, and lookup cursors of parameter functions). The arrays of all
+    // objects are placed contiguously in one block per element type, ordered
+    // by the objects' positions in the group. Each block is allocated once,
+    // when the first object requests its storage (i.e. after all objects have
+    // been added), and the blocks are released in one go by the destructor.
+    // Blocks which are not requested (e.g. by classes derived from
+    // 'sizedObject') are not allocated. A flag is set for each block after its
+    // allocation, so that later requests do not need a lock.
+    vector<double> storage_values;
+    vector<const double*> storage_pointers;
+    vector<tblFunction::size_type> storage_cursors;
+    atomic<bool> storage_values_ready;
+    atomic<bool> storage_pointers_ready;
+    atomic<bool> storage_cursors_ready;
+    unsigned int storage_nObjects;
+    // Storage for the vector state variables of all objects of the group.
+    // Since the number of elements differs between objects, the block is
+    // allocated once the initial values of all objects are known (see
+    // 'store_statesVect').
+    vector<double> storage_statesVect;
+    template <class T>
+    T* storage_slot(const char* func, vector<T> &block, atomic<bool> &ready,
+      const size_t stride, const size_t offset, const unsigned int indexObject);
   public:
     typedef unsigned int size_type;
+    // Number of instances allowed per object group (one per ensemble member)
+    static unsigned int maxInstances;
     // Constructor/desctructor
     abstractObjectGroup ();
     virtual ~abstractObjectGroup ();
@@ -121,6 +154,10 @@ class abstractObjectGroup {
       const string chars_comment);
     void set_tableParamsNum (const string file, const string chars_colsep,
       const string chars_comment);
+    // Use the tables of another group of the same type instead of reading the
+    // same file again (for the members of an ensemble)
+    void set_tableParamsFun (const abstractObjectGroup &source);
+    void set_tableParamsNum (const abstractObjectGroup &source);
     const table & get_tableParamsFun() const;
     const table & get_tableParamsNum() const;
     void clear_tableParamsFun();
@@ -135,43 +172,57 @@ class abstractObjectGroup {
       const string chars_comment);
     void set_sharedParamsNum(const string file, const string chars_colsep,
       const string chars_comment);
+    // Copy the shared parameters of another group of the same type instead of
+    // reading the same file again (function data are not copied but shared)
+    void set_sharedParamsFun(const abstractObjectGroup &source);
+    void set_sharedParamsNum(const abstractObjectGroup &source);
     // Get values of shared parameters
+    // Note: The index is checked unless CHECKED is false. The unchecked variant
+    //       is used by the data access methods of objects compiled without range
+    //       checks (see 'echse_coreClass_objectAccess.h').
+    template<bool CHECKED= true>
     double get_sharedParamNum(const size_type index) const {
-      #if CHECK_RANGE
-      if (index >= sharedParamsNum.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access shared parameter with index " << index <<
-          " of object group '" << idObjectGroup << "'. Index must be in range [0," <<
-          (sharedParamsNum.size()-1) << "].";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
+      if (CHECKED && (index >= sharedParamsNum.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "shared parameter", index, sharedParamsNum.size());
       return(sharedParamsNum[index]);
     }
-    double get_sharedParamFun(const size_type index, const double &arg) {
-      // Note: Can't be const due to lookup index update
-      #if CHECK_RANGE
-      if (index >= sharedParamsFun.size()) {
-        stringstream errmsg;
-        errmsg << "Attempt to access shared parameter function with index " << index <<
-          " of object group '" << idObjectGroup << "'. Index must be in range [0," <<
-          (sharedParamsFun.size()-1) << "].";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
-      }
-      #endif
+    // Note: The shared functions can be evaluated by multiple threads
+    //       concurrently. The optional cursor is owned by the calling object.
+    template<bool CHECKED= true>
+    double get_sharedParamFun(const size_type index, const double &arg) const {
+      if (CHECKED && (index >= sharedParamsFun.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "shared parameter function", index, sharedParamsFun.size());
       try {
         return(sharedParamsFun[index].eval(arg));
       } catch (except) {
-        stringstream errmsg;
-        errmsg << "Cannot return value of shared parameter function with index '" <<
-          index << "' of object group '" << idObjectGroup << "' for argument " <<
-          arg << ". The function's name is '" << namesSharedParamsFun[index] << "'.";
-        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-        throw(e);
+        error_sharedParamFun(__PRETTY_FUNCTION__, index, arg);
+      }
+    }
+    template<bool CHECKED= true>
+    double get_sharedParamFun(const size_type index, const double &arg,
+      tblFunction::size_type &cursor) const {
+      if (CHECKED && (index >= sharedParamsFun.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "shared parameter function", index, sharedParamsFun.size());
+      try {
+        return(sharedParamsFun[index].eval(arg, cursor));
+      } catch (except) {
+        error_sharedParamFun(__PRETTY_FUNCTION__, index, arg);
       }
     }
+    // Get the storage of the per-object arrays (see 'storage_values' etc.) for
+    // the object at position 'indexObject' in the group. The storage is
+    // initialized with zeros (NULL pointers).
+    // Note: These methods may be called by multiple threads concurrently. Objects
+    //       must not be added to the group after the first call.
+    double* storage_paramsNum(const size_type indexObject);
+    double* storage_outputs(const size_type indexObject);
+    const double** storage_inputsSim(const size_type indexObject);
+    tblFunction::size_type* storage_paramsFunCursors(const size_type indexObject);
+    tblFunction::size_type* storage_sharedParamsFunCursors(const size_type indexObject);
+    // Move the values of the vector state variables of all objects of the group
+    // into one block, ordered by the objects' positions in the group. Must be
+    // called after the objects' init_statesVect method (not thread-safe).
+    void store_statesVect();
     // Virtual methods to be redefined in derived classes
     virtual void addObject(const string idObject)= 0;
     virtual unsigned int numObjects() const = 0;
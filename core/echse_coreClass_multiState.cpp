@@ -5,27 +5,34 @@
 // Ctor & Dtor
 ////////////////////////////////////////////////////////////////////////////////
 
-multiState::multiState() { }
+multiState::multiState() {
+  offsets.assign(1, 0);
+  first= NULL;
+}
 
-void multiState::clear() {
-  if (variables.size() > 0) {
-    for (unsigned int i=0; i<variables.size(); i++) {
-      variables[i]->clear();
-      delete variables[i];
-    }
-    variables.clear();
+multiState::multiState(const multiState &m) :
+  values(m.data(), m.data() + m.size()), offsets(m.offsets)
+{
+  first= values.data();
+}
+
+multiState& multiState::operator=(const multiState &m) {
+  if (this != &m) {
+    values.assign(m.data(), m.data() + m.size());
+    offsets= m.offsets;
+    first= values.data();
   }
+  return(*this);
 }
 
-multiState::~multiState() {
-  clear();
+void multiState::clear() {
+  values.clear();
+  offsets.assign(1, 0);
+  first= NULL;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Return number of variables
-////////////////////////////////////////////////////////////////////////////////
-unsigned int multiState::nvars() const {
-  return(variables.size());
+multiState::~multiState() {
+  clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,60 +40,54 @@ unsigned int multiState::nvars() const {
 ////////////////////////////////////////////////////////////////////////////////
 
 void multiState::add(const vector<double> &v) {
-  variables.push_back(NULL);
-  variables[variables.size()-1]= new(nothrow) vector<double>(v);
-  if (!variables[variables.size()-1]) {
+  if ((first != NULL) && (first != values.data())) {
+    except e(__PRETTY_FUNCTION__,"Cannot add vector state variable after the values were moved to external storage.",__FILE__,__LINE__);
+    throw(e);
+  }
+  try {
+    values.insert(values.end(), v.begin(), v.end());
+    offsets.push_back(values.size());
+  } catch (const bad_alloc&) {
     except e(__PRETTY_FUNCTION__,"Memory allocation for new vector state variable failed.",__FILE__,__LINE__);
     throw(e);
   }
+  first= values.data();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Read-access to value(s) of a variable
+// Move the values to external storage
 ////////////////////////////////////////////////////////////////////////////////
 
-const vector<double>& multiState::read_access(unsigned int indexVariable) const {
-  if (indexVariable >= variables.size()) {
-    stringstream errmsg;
-    errmsg << "Cannot access vector state variable with index " << indexVariable <<
-      ". Index out of range [0," << (variables.size()-1) << "].";
-    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-    throw(e);
-  }
-  return(*variables[indexVariable]);
+void multiState::bind(double* p) {
+  if (size() == 0) return;
+  copy(first, first + size(), p);
+  vector<double>().swap(values);
+  first= p;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Full access to value(s) of a variable
+// Error raised by the access methods
 ////////////////////////////////////////////////////////////////////////////////
 
-vector<double>& multiState::full_access(unsigned int indexVariable) {
-  if (indexVariable >= variables.size()) {
-    stringstream errmsg;
-    errmsg << "Cannot access vector state variable with index " << indexVariable <<
-      ". Index out of range [0," << (variables.size()-1) << "].";
-    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-    throw(e);
-  }
-  return(*variables[indexVariable]);
+void multiState::error_index(const char* method, const unsigned int indexVariable) const {
+  stringstream errmsg;
+  errmsg << "Cannot access vector state variable with index " << indexVariable <<
+    ". Index out of range [0," << (static_cast<int>(nvars())-1) << "].";
+  except e(method,errmsg,__FILE__,__LINE__);
+  throw(e);
 }
 
-
 ////////////////////////////////////////////////////////////////////////////////
-// Set values of an existing variable (with possibly changed dimension)
+// Access to the values of all variables
 ////////////////////////////////////////////////////////////////////////////////
-/*
-void multiState::set(unsigned int indexVariable, const vector<double> &v) {
-  const string method="multiState::set";
-  if (indexVariable >= variables.size()) {
-    stringstream errmsg;
-    errmsg << "Cannot set vector state variable with index " << indexVariable <<
-      ". Index out of range [0," << (variables.size()-1) << "].";
-    except e(method,errmsg,__FILE__,__LINE__);
-    throw(e);
-  }
-  variables[indexVariable]->assign(v.begin(), v.end());
-}
-*/
 
+unsigned int multiState::size() const {
+  return(offsets.back());
+}
+const double* multiState::data() const {
+  return(first);
+}
+double* multiState::data() {
+  return(first);
+}
 
@@ -1,31 +1,121 @@
-
 #ifndef ECHSE_CORECLASS_MULTISTATE_H
 #define ECHSE_CORECLASS_MULTISTATE_H
 
 #include <vector>
 #include <sstream>
 #include <string>
+#include <algorithm>
+#include <new>
 
 #include "except/except.h"
 #include "table/table.h"
 
+#include "echse_options.h"
+
 using namespace std;
 
+////////////////////////////////////////////////////////////////////////////////
+// Class template 'vectorView'
+//
+// View of the values of a vector state variable stored in a 'multiState'.
+// The view supports element access, size() and iteration like a vector but
+// its size cannot be changed. Use 'vectorView<double>' for full access and
+// 'vectorView<const double>' for read-only access. A view remains valid until
+// variables are added to or removed from the 'multiState'.
+// In model code, a view is best declared as 'auto', e.g.
+//   auto v= set_stateVect(index);
+//   for (unsigned int i=0; i<v.size(); i++) v[i]= ...;
+////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class vectorView {
+  private:
+    T* first;
+    unsigned int n;
+    void check_size(const unsigned int nvalues) const {
+      if (nvalues != n) {
+        stringstream errmsg;
+        errmsg << "Cannot assign " << nvalues << " value(s) to vector state" <<
+          " variable with " << n << " element(s). The number of elements of a" <<
+          " vector state variable cannot be changed.";
+        except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+        throw(e);
+      }
+    }
+  public:
+    // Constructors (the second one converts a full view into a read-only view)
+    vectorView(T* first, const unsigned int n) : first(first), n(n) { }
+    template <class U>
+    vectorView(const vectorView<U> &v) : first(v.begin()), n(v.size()) { }
+    // Size and element access
+    unsigned int size() const { return(n); }
+    bool empty() const { return(n == 0); }
+    T& operator[](const unsigned int i) const { return(first[i]); }
+    T* begin() const { return(first); }
+    T* end() const { return(first + n); }
+    // Copy of the values
+    operator vector<double>() const { return(vector<double>(first, first + n)); }
+    // Assignment of values (the number of values must match)
+    vectorView& operator=(const vector<double> &v) {
+      check_size(v.size());
+      copy(v.begin(), v.end(), first);
+      return(*this);
+    }
+    vectorView& operator=(const vectorView &v) {
+      check_size(v.size());
+      copy(v.begin(), v.end(), first);
+      return(*this);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'multiState'
+//
+// Holds the vector state variables of an object. The values of all variables
+// are stored contiguously in a single array (ragged-array layout) with the
+// start of each variable given by an array of offsets. The array is owned by
+// the 'multiState' while variables are added. Once the sizes are final, the
+// values can be moved to external storage (see 'bind'), e.g. the storage of
+// the object group.
+////////////////////////////////////////////////////////////////////////////////
+
 class multiState {
   private:
-    vector< vector<double>* > variables;
+    vector<double> values;        // Own storage of the values (empty if bound)
+    vector<unsigned int> offsets; // Start of the variables (plus the total size)
+    double* first;                // Values actually in use (own or external)
+    [[noreturn]] void error_index(const char* method,
+      const unsigned int indexVariable) const ECHSE_COLD;
   public:
-    // Ctor, Dtor
+    // Ctor, Dtor (a copy always holds the values in its own storage)
     multiState ();
+    multiState (const multiState &m);
+    multiState& operator=(const multiState &m);
     ~multiState ();
     // Clear method
     void clear();
     // Return number of variables
-    unsigned int nvars() const;
+    unsigned int nvars() const { return(offsets.size() - 1); }
     // Get & set methods
     void add(const vector<double> &v);
-    const vector<double>& read_access(unsigned int indexVariable) const;
-    vector<double>& full_access(unsigned int indexVariable);
+    // Move the values to external storage of at least size() elements. No
+    // variables can be added afterwards (except after clear()).
+    void bind(double* p);
+    vectorView<const double> read_access(unsigned int indexVariable) const {
+      if (indexVariable >= nvars()) error_index(__PRETTY_FUNCTION__, indexVariable);
+      return(vectorView<const double>(first + offsets[indexVariable],
+        offsets[indexVariable+1] - offsets[indexVariable]));
+    }
+    vectorView<double> full_access(unsigned int indexVariable) {
+      if (indexVariable >= nvars()) error_index(__PRETTY_FUNCTION__, indexVariable);
+      return(vectorView<double>(first + offsets[indexVariable],
+        offsets[indexVariable+1] - offsets[indexVariable]));
+    }
+    // Access to the values of all variables at once (e.g. to save and restore
+    // states)
+    unsigned int size() const;
+    const double* data() const;
+    double* data();
 };
 
 #endif
@@ -0,0 +1,150 @@
+#ifndef ECHSE_CORECLASS_OBJECTACCESS_H
+#define ECHSE_CORECLASS_OBJECTACCESS_H
+
+#include <vector>
+
+#include "except/except.h"
+#include "functions/functions.h"
+
+#include "echse_coreClass_abstractObject.h"
+#include "echse_coreClass_abstractObjectGroup.h"
+#include "echse_coreClass_multiState.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Class template 'objectAccess'
+//
+// Data access methods used by the developer of a specific object (= user
+// interface) in the simulate() and derivsScal() methods. The object classes
+// created by the code generator derive from 'abstractObject', which is the
+// name of an instance of this template in the namespaces of the two model
+// variants (see 'echse_coreFunct_modelVariants.h'):
+//   - objectAccess<false>: Indices are not checked. The methods contain
+//                          neither a check nor a test of a run-time flag.
+//   - objectAccess<true>:  Indices are checked for out-of-range conditions.
+//                          Use this for untested models!
+// Both variants are compiled into every engine. The variant is selected when
+// the object groups are instantiated (key 'check_range' of the control file).
+////////////////////////////////////////////////////////////////////////////////
+
+template<bool CHECKED>
+class objectAccess : public abstractObject {
+  protected:
+    // FULL access to states and outputs for use at the LEFT hand side of expressions
+    // in the simulate() method of derived classes. This is accomplished by the
+    // use of non-const references.
+    double& set_output(const T_index_output &index) {
+      if (CHECKED && (index.index >= nOutputs))
+        error_indexRange(__PRETTY_FUNCTION__, "output variable", index.index, nOutputs);
+      return(outputsPtr[index.index]);
+    }
+    // Access to single item
+    double& set_stateScal(const T_index_stateScal &index) {
+      if (CHECKED && (index.index >= statesScal.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "scalar state variable", index.index, statesScal.size());
+      return(statesScal[index.index]);
+    }
+    // Access to entire vector
+    vector<double>& set_stateScal_all() {
+      return(statesScal);
+    }
+    vectorView<double> set_stateVect(const T_index_stateVect &index) {
+      if (CHECKED && (index.index >= statesVect.nvars()))
+        error_indexRange(__PRETTY_FUNCTION__, "vector state variable", index.index, statesVect.nvars());
+      return(statesVect.full_access(index.index));
+    }
+  public:
+    // READ-ONLY access to parameters, states, inputs, and outputs for use at
+    // the RIGHT hand side of expressions in the simulate() method of derived classes.
+    // Scalar numbers and function results are returned by value, vectors as const references.
+    // Individual
+    double paramNum(const T_index_paramNum &index) const {
+      if (CHECKED && (index.index >= nParamsNum))
+        error_indexRange(__PRETTY_FUNCTION__, "individual scalar parameter", index.index, nParamsNum);
+      return(paramsNumPtr[index.index]);
+    }
+    // Shared
+    double sharedParamNum(const T_index_sharedParamNum &index) const {
+      try {
+        return( objectGroupPointer->get_sharedParamNum<CHECKED>(index.index) );
+      } catch (except) {
+        error_sharedParamNum(__PRETTY_FUNCTION__, index.index);
+      }
+    }
+    // Individual
+    double paramFun(const T_index_paramFun &index, const double &arg) {
+      // Note: Can't be const due to update of the object's lookup cursor
+      if (CHECKED && (index.index >= paramsFun.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "individual parameter function", index.index, paramsFun.size());
+      try {
+        return(paramsFun[index.index].eval(arg, paramsFunCursors[index.index]));
+      } catch (except) {
+        error_paramFun(__PRETTY_FUNCTION__, false, index.index, arg);
+      }
+    }
+    // Shared
+    double sharedParamFun(const T_index_sharedParamFun &index, const double &arg) {
+      // Note: Can't be const due to update of the object's lookup cursor. The
+      //       function itself is shared by all objects of the group.
+      if (CHECKED && (index.index >= nSharedParamsFun))
+        error_indexRange(__PRETTY_FUNCTION__, "shared parameter function", index.index, nSharedParamsFun);
+      try {
+        return( objectGroupPointer->get_sharedParamFun<CHECKED>(index.index, arg,
+          sharedParamsFunCursors[index.index]) );
+      } catch (except) {
+        error_paramFun(__PRETTY_FUNCTION__, true, index.index, arg);
+      }
+    }
+    double inputExt(const T_index_inputExt &index) const {
+      double result;
+      if (CHECKED && (index.index >= inputsExt.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "external input variable", index.index, inputsExt.size());
+      result= 0.;
+      for (unsigned int i=0; i<inputsExt[index.index].size(); i++) {
+        result= result + (*inputsExt[index.index][i].valPtr) * inputsExt[index.index][i].weight;
+      }
+      return(result);
+    }
+    double inputSim(const T_index_inputSim &index) const {
+      if (CHECKED && (index.index >= nInputsSim))
+        error_indexRange(__PRETTY_FUNCTION__, "simulated input variable", index.index, nInputsSim);
+      return(*inputsSimPtr[index.index]);
+    }
+    // Single item
+    double stateScal(const T_index_stateScal &index) const {
+      if (CHECKED && (index.index >= statesScal.size()))
+        error_indexRange(__PRETTY_FUNCTION__, "scalar state variable", index.index, statesScal.size());
+      return(statesScal[index.index]);
+    }
+    // Entire vector
+    const vector<double>& stateScal_all() const {
+      return(statesScal);
+    }
+    vectorView<const double> stateVect(const T_index_stateVect &index) const {
+      if (CHECKED && (index.index >= statesVect.nvars()))
+        error_indexRange(__PRETTY_FUNCTION__, "vector state variable", index.index, statesVect.nvars());
+      return(statesVect.read_access(index.index));
+    }
+    double output(const T_index_output &index) const {
+      if (CHECKED && (index.index >= nOutputs))
+        error_indexRange(__PRETTY_FUNCTION__, "output variable", index.index, nOutputs);
+      return(outputsPtr[index.index]);
+    }
+    // Checks whether scalar parameters are within range [lower, upper]
+    void checkParamNum (const T_index_paramNum &index,
+      const double lower, const double upper) const {
+      const double value= paramNum(index);
+      if ((value < lower) || (value > upper))
+        error_paramRange(__PRETTY_FUNCTION__, false, index.index, value, lower, upper);
+    }
+    void checkSharedParamNum (const T_index_sharedParamNum &index,
+      const double lower, const double upper) const {
+      const double value= sharedParamNum(index);
+      if ((value < lower) || (value > upper))
+        error_paramRange(__PRETTY_FUNCTION__, true, index.index, value, lower, upper);
+    }
+};
+
+#endif
+
@@ -0,0 +1,252 @@
+
+#include "echse_coreClass_outputSink.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'scoreAccumulator'
+////////////////////////////////////////////////////////////////////////////////
+
+void scoreAccumulator::clear() {
+  n= 0;
+  mean_obs= 0.;
+  mean_sim= 0.;
+  m2_obs= 0.;
+  m2_sim= 0.;
+  c_obssim= 0.;
+  sse= 0.;
+}
+
+void scoreAccumulator::check(const char* func, const bool needVariance) const {
+  if (n < 2) {
+    stringstream errmsg;
+    errmsg << "Cannot compute score from " << n << " pair(s) of observed and" <<
+      " simulated values.";
+    except e(func, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  if (needVariance && ((m2_obs <= 0.) || (m2_sim <= 0.))) {
+    except e(func, "Cannot compute score for constant series of observed or simulated values.",
+      __FILE__, __LINE__);
+    throw(e);
+  }
+}
+
+double scoreAccumulator::nse() const {
+  check(__PRETTY_FUNCTION__, false);
+  if (m2_obs <= 0.) {
+    except e(__PRETTY_FUNCTION__, "Cannot compute score for constant series of observed values.",
+      __FILE__, __LINE__);
+    throw(e);
+  }
+  return(1. - sse / m2_obs);
+}
+
+double scoreAccumulator::kge() const {
+  check(__PRETTY_FUNCTION__, true);
+  if (mean_obs == 0.) {
+    except e(__PRETTY_FUNCTION__, "Cannot compute score for observed values with zero mean.",
+      __FILE__, __LINE__);
+    throw(e);
+  }
+  const double r= c_obssim / sqrt(m2_obs * m2_sim);
+  const double alpha= sqrt(m2_sim / m2_obs);
+  const double beta= mean_sim / mean_obs;
+  return(1. - sqrt((r - 1.) * (r - 1.) + (alpha - 1.) * (alpha - 1.) +
+    (beta - 1.) * (beta - 1.)));
+}
+
+double scoreAccumulator::rmse() const {
+  check(__PRETTY_FUNCTION__, false);
+  return(sqrt(sse / n));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'outputSink': Ctor, Dtor
+////////////////////////////////////////////////////////////////////////////////
+
+outputSink::outputSink() {
+  timeObs.set(0);
+}
+
+outputSink::~outputSink() {
+  clear();
+}
+
+void outputSink::clear() {
+  for (unsigned int i=0; i<series.size(); i++) {
+    delete series[i].obs;
+  }
+  series.clear();
+  timeObs.set(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Add series
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int outputSink::add(const string &name, const double* value) {
+  if (value == NULL) {
+    stringstream errmsg;
+    errmsg << "Cannot add series '" << name << "'. Address of output is undefined.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  series.push_back(T_series());
+  series.back().name= name;
+  series.back().value= value;
+  series.back().obs= NULL;
+  series.back().indexLocation= 0;
+  series.back().sseMax= numeric_limits<double>::infinity();
+  return(series.size() - 1);
+}
+
+unsigned int outputSink::add(const string &name, const double* value,
+  const string &file_obs, const string &idLocation,
+  const string &chars_colsep, const string &chars_comment,
+  const unsigned int bufferSize)
+{
+  const unsigned int index= add(name, value);
+  T_series &s= series[index];
+  try {
+    s.obs= new spaceTimeData();
+    s.obs->init(file_obs, chars_colsep, chars_comment, true, false, bufferSize);
+    const vector<string> &locations= s.obs->get_locations();
+    unsigned int k= 0;
+    while ((k < locations.size()) && (locations[k] != idLocation)) k++;
+    if (k == locations.size()) {
+      stringstream errmsg;
+      errmsg << "Location '" << idLocation << "' not found.";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      throw(e);
+    }
+    s.indexLocation= k;
+  } catch (except) {
+    delete s.obs;
+    series.pop_back();
+    stringstream errmsg;
+    errmsg << "Cannot initialize observations for series '" << name <<
+      "' from file '" << file_obs << "'.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  return(index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Collection of values
+////////////////////////////////////////////////////////////////////////////////
+
+void outputSink::begin(const fixedZoneTime &start, const unsigned int numberOfSteps) {
+  const bool rewind= (start < timeObs);
+  for (unsigned int i=0; i<series.size(); i++) {
+    T_series &s= series[i];
+    // No reallocation during the run (capacity is kept for later runs)
+    s.values.clear();
+    s.values.reserve(numberOfSteps);
+    s.scores.clear();
+    if (rewind && (s.obs != NULL)) {
+      try {
+        s.obs->rewind();
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot rewind observations for series '" << s.name << "'.";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+    }
+  }
+}
+
+void outputSink::collect(const fixedZoneTime &stepStart, const fixedZoneTime &stepEnd) {
+  for (unsigned int i=0; i<series.size(); i++) {
+    T_series &s= series[i];
+    const double sim= *s.value;
+    s.values.push_back(sim);
+    if (s.obs != NULL) {
+      try {
+        s.obs->update(stepStart, stepEnd);
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot update observations for series '" << s.name << "'.";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+      const double obs= s.obs->get_value(s.indexLocation);
+      if (std::isfinite(obs)) s.scores.add(obs, sim);
+    }
+  }
+  timeObs= stepEnd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Limits
+////////////////////////////////////////////////////////////////////////////////
+
+void outputSink::set_limitSSE(const unsigned int index, const double sseMax) {
+  const T_series &s= get_series(__PRETTY_FUNCTION__, index);
+  if (s.obs == NULL) {
+    stringstream errmsg;
+    errmsg << "No observations defined for series '" << s.name << "'.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  if (!(sseMax >= 0.)) {
+    stringstream errmsg;
+    errmsg << "Bad limit of the sum of squared errors for series '" << s.name <<
+      "' (" << sseMax << ").";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  series[index].sseMax= sseMax;
+}
+
+bool outputSink::limitExceeded(string &reason) const {
+  for (unsigned int i=0; i<series.size(); i++) {
+    const T_series &s= series[i];
+    // Note: Condition is also true for a non-finite sum
+    if (!(s.scores.get_sse() <= s.sseMax)) {
+      stringstream msg;
+      msg << "Sum of squared errors for series '" << s.name << "' (" <<
+        s.scores.get_sse() << ") exceeds the limit (" << s.sseMax << ").";
+      reason= msg.str();
+      return(true);
+    }
+  }
+  return(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Results
+////////////////////////////////////////////////////////////////////////////////
+
+const outputSink::T_series& outputSink::get_series(const char* func,
+  const unsigned int index) const
+{
+  if (index >= series.size()) {
+    stringstream errmsg;
+    errmsg << "Bad index of series (" << index << "). Number of series is " <<
+      series.size() << ".";
+    except e(func, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  return(series[index]);
+}
+
+unsigned int outputSink::size() const {
+  return(series.size());
+}
+
+const vector<double>& outputSink::get_values(const unsigned int index) const {
+  return(get_series(__PRETTY_FUNCTION__, index).values);
+}
+
+const scoreAccumulator& outputSink::get_scores(const unsigned int index) const {
+  const T_series &s= get_series(__PRETTY_FUNCTION__, index);
+  if (s.obs == NULL) {
+    stringstream errmsg;
+    errmsg << "No observations defined for series '" << s.name << "'.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  return(s.scores);
+}
+
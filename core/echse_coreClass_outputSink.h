@@ -0,0 +1,124 @@
+#ifndef ECHSE_CORECLASS_OUTPUTSINK_H
+#define ECHSE_CORECLASS_OUTPUTSINK_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <limits>
+
+#include "except/except.h"
+#include "fixedZoneTime/fixedZoneTime.h"
+#include "spaceTimeData/spaceTimeData.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'scoreAccumulator'
+//
+// Goodness-of-fit of simulated versus observed values, updated pair by pair
+// (no storage of the series). Means, variances, and the covariance are
+// computed with Welford's algorithm to avoid cancellation in long series.
+//   NSE:  Nash-Sutcliffe efficiency
+//   KGE:  Kling-Gupta efficiency (Gupta et al., 2009)
+//   RMSE: Root mean square error
+////////////////////////////////////////////////////////////////////////////////
+
+class scoreAccumulator {
+  private:
+    unsigned int n;
+    double mean_obs, mean_sim;
+    double m2_obs, m2_sim;    // Sums of squared deviations from the mean
+    double c_obssim;          // Sum of products of deviations
+    double sse;               // Sum of squared errors
+    void check(const char* func, const bool needVariance) const;
+  public:
+    scoreAccumulator() { clear(); }
+    void clear();
+    void add(const double obs, const double sim) {
+      n++;
+      const double d_obs= obs - mean_obs;
+      const double d_sim= sim - mean_sim;
+      mean_obs+= d_obs / n;
+      mean_sim+= d_sim / n;
+      m2_obs+= d_obs * (obs - mean_obs);
+      m2_sim+= d_sim * (sim - mean_sim);
+      c_obssim+= d_obs * (sim - mean_sim);
+      sse+= (sim - obs) * (sim - obs);
+    }
+    unsigned int size() const { return(n); }
+    double nse() const;
+    double kge() const;
+    double rmse() const;
+    // Sum of squared errors and sum of squared deviations of the observations
+    // from their mean (note: NSE = 1 - sse / ssd_obs)
+    double get_sse() const { return(sse); }
+    double get_ssdObs() const { return(m2_obs); }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'outputSink'
+//
+// Collects the values of selected outputs in memory during a simulation (see
+// 'simulation::set_outputSink'). Each series refers to the address of an
+// output (see 'simulation::get_outputAddress'). The arrays of values are
+// allocated once per run. Optionally, a series is compared against observed
+// values in a file of the 'spaceTimeData' format (values assigned to the end
+// of an interval, average values). The scores are updated in every time step.
+// Time steps with a non-finite observation (e.g. 'nan') are not used for the
+// scores.
+// The observation files are read sequentially. They are rewound if a run
+// starts before the end of the previous one (see 'spaceTimeData::rewind').
+// An upper limit of the sum of squared errors can be set for a series to stop
+// hopeless runs early (see 'simulation::set_stopInterval'). Since the sum can
+// only grow during a run, an exceedance is final. A required minimum NSE over
+// the simulation period translates into sseMax = (1 - NSE_min) * ssd_obs, with
+// ssd_obs taken from the scores of any previous run over the same period.
+////////////////////////////////////////////////////////////////////////////////
+
+class outputSink {
+  private:
+    struct T_series {
+      string name;
+      const double* value;
+      vector<double> values;
+      // Observations (optional)
+      spaceTimeData* obs;
+      unsigned int indexLocation;
+      scoreAccumulator scores;
+      double sseMax;            // Upper limit of the sum of squared errors
+    };
+    vector<T_series> series;
+    fixedZoneTime timeObs;      // End of the last update of observations
+    const T_series& get_series(const char* func, const unsigned int index) const;
+    // Don't allow assignment or copy construction (made private + not implemented)
+    outputSink& operator=(const outputSink &x);
+    outputSink(const outputSink &x);
+  public:
+    // Ctor & dtor
+    outputSink();
+    ~outputSink();
+    // Add a series (returns the index of the series)
+    unsigned int add(const string &name, const double* value);
+    unsigned int add(const string &name, const double* value,
+      const string &file_obs, const string &idLocation,
+      const string &chars_colsep, const string &chars_comment,
+      const unsigned int bufferSize);
+    // Called by the simulation at the start of a run and after each time step
+    void begin(const fixedZoneTime &start, const unsigned int numberOfSteps);
+    void collect(const fixedZoneTime &stepStart, const fixedZoneTime &stepEnd);
+    // Set an upper limit of the sum of squared errors for a series with
+    // observations (infinite by default)
+    void set_limitSSE(const unsigned int index, const double sseMax);
+    // Returns true (and the reason) if the limit is exceeded for any series
+    bool limitExceeded(string &reason) const;
+    // Results of the last run
+    unsigned int size() const;
+    const vector<double>& get_values(const unsigned int index) const;
+    const scoreAccumulator& get_scores(const unsigned int index) const;
+    // Remove all series
+    void clear();
+};
+
+#endif
+
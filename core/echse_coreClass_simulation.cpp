@@ -0,0 +1,1050 @@
+
+#include "echse_coreClass_simulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <functional>
+
+#include "omp.h"
+
+#include "typeconv/typeconv.h"
+#include "table/table.h"
+
+#include "echse_options.h"
+#include "echse_globalConst.h"
+#include "echse_coreClass_templateObjectGroup.h"
+#include "echse_coreClass_stateWriter.h"
+#include "echse_coreFunct_instantiateObjects.h"
+#include "echse_coreFunct_checkpoint.h"
+#include "echse_coreFunct_simulateStep.h"
+#include "echse_coreFunct_setObjectLevels.h"
+#include "echse_coreFunct_util.h"
+#include "echse_coreFunct_initObjects.h"
+#include "echse_coreFunct_modelVariants.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Ctor, Dtor
+////////////////////////////////////////////////////////////////////////////////
+
+simulation::simulation() {
+  singlethread_if_less_than= 0;
+  trap_fpe= false;
+  check_range= false;
+  saveFinalState= false;
+  save_checkpoints= false;
+  delta_t= 0;
+  loaded= false;
+  fileOutput= true;
+  fileOutput_done= false;
+  timeInputs.set(0);
+  sink= NULL;
+  stop_interval= 0;
+  stop_nonFinite= false;
+  lg= NULL;
+  silent= true;
+}
+
+simulation::~simulation() {
+  clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Logging (optional)
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::log(const string &message) {
+  if (lg != NULL) lg->add(silent, message);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Checks
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::check_loaded(const char* func) const {
+  if (!loaded) {
+    except e(func, "Model has not been loaded.", __FILE__, __LINE__);
+    throw(e);
+  }
+}
+
+abstractObject* simulation::get_object(const char* func, const string &idObject,
+  const unsigned int member) const
+{
+  check_loaded(func);
+  if (member >= members.size()) {
+    stringstream errmsg;
+    errmsg << "Bad index of ensemble member (" << member << "). Number of" <<
+      " members is " << members.size() << ".";
+    except e(func, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  const map<string, unsigned int> &objectIndices= members[member].objectIndices;
+  map<string, unsigned int>::const_iterator it= objectIndices.find(idObject);
+  if (it == objectIndices.end()) {
+    stringstream errmsg;
+    errmsg << "Object with id '" << idObject << "' does not exist.";
+    except e(func, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  return(members[member].objects[it->second]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Set up the model
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::load(const settings &control, logfile* lg, const bool silent) {
+  string input_colsep, input_commentchar;
+  string file_ensemble;
+  unsigned int number_of_threads;
+
+  if (loaded) {
+    except e(__PRETTY_FUNCTION__, "Model has already been loaded.", __FILE__, __LINE__);
+    throw(e);
+  }
+  clear();  // Data of a failed attempt, if any
+  this->lg= lg;
+  this->silent= silent;
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Querying frequently used control data");
+  try {
+    input_colsep= control["input_columnSeparator"];
+    input_commentchar= control["input_lineComment"];
+    output_colsep= control["output_columnSeparator"];
+    output_commentchar= control["output_lineComment"];
+    outfmt= control["outputFormat"];
+    outdir= control["outputDirectory"];
+    saveFinalState= as_logical(control["saveFinalState"]);
+    number_of_threads= max(as_unsigned_integer(1), as_unsigned_integer(control["number_of_threads"]));
+    singlethread_if_less_than= max(as_unsigned_integer(0), as_unsigned_integer(control["singlethread_if_less_than"]));
+    trap_fpe= as_logical(control["trap_fpe"]); 
+    check_range= as_logical(control["check_range"]);
+    save_checkpoints= as_logical(control["save_checkpoints"]);
+    file_ensemble= control["table_ensemble"];
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Missing or bad setting(s) in control data.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Report the state of the range checks
+  if (check_range) {
+    log("Range checks in data access functions: ACTIVE");
+  } else {
+    log("Range checks in data access functions: DISABLED");
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Setting number of threads");
+  number_of_threads= min(number_of_threads, as_unsigned_integer(omp_get_max_threads()));
+  omp_set_num_threads(number_of_threads);
+  log("Number of threads (if >=" + as_string(singlethread_if_less_than) +
+    " parallel objects): " + as_string(number_of_threads));
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Setting up ensemble members");
+  try {
+    if (file_ensemble == "none") {
+      members.resize(1);
+      members[0].outdir= outdir;
+    } else {
+      // Table with columns member, key, file: For each member, files to be
+      // used instead of those given in the control file. Only the files of
+      // numeric parameters may differ between members.
+      table tab;
+      vector<string> vect_member, vect_key, vect_file;
+      tab.read(file_ensemble, true, input_colsep, input_commentchar);
+      try {
+        tab.get_col(tab.colindex(globalConst::colNames.member), vect_member);
+        tab.get_col(tab.colindex(globalConst::colNames.key), vect_key);
+        tab.get_col(tab.colindex(globalConst::colNames.fileName), vect_file);
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot retrieve data from ensemble table ('" << file_ensemble <<
+          "'). Expecting columns '" << globalConst::colNames.member << "', '" <<
+          globalConst::colNames.key << "', and '" << globalConst::colNames.fileName << "'.";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+      if (vect_member.empty()) {
+        stringstream errmsg;
+        errmsg << "Ensemble table ('" << file_ensemble << "') does not define any member.";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+      for (unsigned int i=0; i<vect_member.size(); i++) {
+        const string &key= vect_key[i];
+        const string suffix_ind= "_numParamsIndividual";
+        const string suffix_shr= "_numParamsShared";
+        if (!(((key.size() > suffix_ind.size()) &&
+               (key.compare(key.size() - suffix_ind.size(), suffix_ind.size(), suffix_ind) == 0)) ||
+              ((key.size() > suffix_shr.size()) &&
+               (key.compare(key.size() - suffix_shr.size(), suffix_shr.size(), suffix_shr) == 0)))) {
+          stringstream errmsg;
+          errmsg << "Bad key '" << key << "' in ensemble table ('" << file_ensemble <<
+            "'). Only the files of numeric parameters ('<objectGroup>" << suffix_ind <<
+            "' or '<objectGroup>" << suffix_shr << "') can be set per member.";
+          except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+          throw(e);
+        }
+        // Members are numbered in order of their first appearance
+        unsigned int m= 0;
+        while ((m < members.size()) && (members[m].id != vect_member[i])) m++;
+        if (m == members.size()) {
+          members.resize(m+1);
+          members[m].id= vect_member[i];
+          members[m].outdir= outdir + "/" + vect_member[i];
+        }
+        if (!members[m].files.insert(make_pair(key, vect_file[i])).second) {
+          stringstream errmsg;
+          errmsg << "Duplicate key '" << key << "' for member '" << vect_member[i] <<
+            "' in ensemble table ('" << file_ensemble << "').";
+          except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+          throw(e);
+        }
+      }
+    }
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to set up ensemble members.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Number of ensemble members: " + as_string(members.size()));
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Instantiating object groups");
+  // Function from generated code! The variant of the object classes with or
+  // without range checks is selected here (see 'echse_coreFunct_modelVariants.h').
+  abstractObjectGroup::maxInstances= members.size();
+  for (unsigned int m=0; m<members.size(); m++) {
+    if (check_range) {
+      instantiateObjectGroups_checked(members[m].objectGroups);
+    } else {
+      instantiateObjectGroups_unchecked(members[m].objectGroups);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Instantiating objects");
+  try {
+    instantiateObjects(control["table_objectDeclaration"], input_colsep, input_commentchar,
+      members[0].objectGroups, members[0].objects);
+    for (unsigned int m=1; m<members.size(); m++) {
+      instantiateObjects(members[0].objectGroups, members[m].objectGroups,
+        members[m].objects);
+    }
+    for (unsigned int m=0; m<members.size(); m++) {
+      objects.insert(objects.end(), members[m].objects.begin(), members[m].objects.end());
+    }
+    // Index of the objects of each member (used for the object linkage and
+    // the access to particular objects)
+    for (unsigned int m=0; m<members.size(); m++) {
+      for (unsigned int i=0; i<members[m].objects.size(); i++) {
+        if (!members[m].objectIndices.insert(make_pair(
+              members[m].objects[i]->get_idObject(), i)).second) {
+          except e(__PRETTY_FUNCTION__, "Cannot create map of object IDs.", __FILE__, __LINE__);
+          throw(e);
+        }
+      }
+    }
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__,"Failed to instantiate object(s).",__FILE__,__LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Reading of input data
+  // The input tables and data files are independent of each other. They are
+  // read concurrently (one task per file) before any object is initialized.
+  // Tables used for the initialization of objects are kept in memory until
+  // the respective step has been completed.
+  log("Reading input tables and data files (concurrently)");
+  table tab_selectedOutput, tab_debugOutput, tab_stateOutput,
+    tab_inputOutputRelations, tab_externalInputLocations,
+    tab_initialValuesScal, tab_initialValuesVect;
+  try {
+    vector< function<void()> > tasks;
+    tasks.push_back([&]() {
+      try {
+        tab_selectedOutput.read(control["table_selectedOutput"], true, input_colsep, input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read table of selected outputs.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    tasks.push_back([&]() {
+      try {
+        tab_debugOutput.read(control["table_debugOutput"], true, input_colsep, input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read table of debug outputs.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    tasks.push_back([&]() {
+      try {
+        // We expect a one-column table with times in ISO format --> don't use space as colsep
+        tab_stateOutput.read(control["table_stateOutput"], true, "\t", input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read table of state output times.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    tasks.push_back([&]() {
+      try {
+        tab_inputOutputRelations.read(control["table_inputOutputRelations"], true, input_colsep, input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read object linkage table.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    // Parameters of the object groups: Each distinct file is read only once,
+    // by the first member using it. The corresponding groups of the other
+    // members share the data (see 'shares' below).
+    enum T_paramKind { funParamsIndividual, numParamsIndividual,
+      funParamsShared, numParamsShared };
+    const string paramSuffixes[4]= {"_funParamsIndividual", "_numParamsIndividual",
+      "_funParamsShared", "_numParamsShared"};
+    struct T_share {
+      abstractObjectGroup* group;
+      const abstractObjectGroup* source;
+      T_paramKind kind;
+    };
+    vector<T_share> shares;
+    for (unsigned int k=0; k<members[0].objectGroups.size(); k++) {
+      for (unsigned int n=0; n<4; n++) {
+        const T_paramKind kind= static_cast<T_paramKind>(n);
+        const string key= members[0].objectGroups[k]->get_idObjectGroup() + paramSuffixes[n];
+        map<string, unsigned int> firstMember;  // File name --> member reading the file
+        for (unsigned int m=0; m<members.size(); m++) {
+          abstractObjectGroup* group= members[m].objectGroups[k];
+          // The file may be member-specific
+          map<string, string>::const_iterator it= members[m].files.find(key);
+          const string file= (it != members[m].files.end()) ? it->second : control[key];
+          pair<map<string, unsigned int>::iterator, bool> res=
+            firstMember.insert(make_pair(file, m));
+          if (!res.second) {
+            T_share share= {group, members[res.first->second].objectGroups[k], kind};
+            shares.push_back(share);
+            continue;
+          }
+          switch (kind) {
+            case funParamsIndividual:
+              tasks.push_back([&, group, file]() {
+                try {
+                  group->set_tableParamsFun(file, input_colsep, input_commentchar);
+                } catch (except) {
+                  stringstream errmsg;
+                  errmsg << "Failed to read table of individual parameter functions for objects of object group '" <<
+                    group->get_idObjectGroup() << "'.";
+                  except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+                  throw(e);
+                }
+              });
+              break;
+            case numParamsIndividual:
+              tasks.push_back([&, group, file]() {
+                try {
+                  group->set_tableParamsNum(file, input_colsep, input_commentchar);
+                } catch (except) {
+                  stringstream errmsg;
+                  errmsg << "Failed to read table of individual scalar parameters for objects of object group '" <<
+                    group->get_idObjectGroup() << "'.";
+                  except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+                  throw(e);
+                }
+              });
+              break;
+            case funParamsShared:
+              tasks.push_back([&, group, file]() {
+                try {
+                  group->set_sharedParamsFun(file, input_colsep, input_commentchar);
+                } catch (except) {
+                  stringstream errmsg;
+                  errmsg << "Failed to set shared parameter functions for object group '" <<
+                    group->get_idObjectGroup() << "'.";
+                  except e(__PRETTY_FUNCTION__,errmsg, __FILE__, __LINE__);
+                  throw(e);
+                }
+              });
+              break;
+            case numParamsShared:
+              tasks.push_back([&, group, file]() {
+                try {
+                  group->set_sharedParamsNum(file, input_colsep, input_commentchar);
+                } catch (except) {
+                  stringstream errmsg;
+                  errmsg << "Failed to set shared scalar parameters for object group '" <<
+                    group->get_idObjectGroup() << "'.";
+                  except e(__PRETTY_FUNCTION__,errmsg, __FILE__, __LINE__);
+                  throw(e);
+                }
+              });
+              break;
+          }
+        }
+      }
+    }
+    tasks.push_back([&]() {
+      try {
+        unsigned int bufferSize= as_unsigned_integer(control["externalInput_bufferSize"]);
+        externalInputs.init(control["table_externalInput_datafiles"],
+          input_colsep, input_commentchar, bufferSize);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Cannot initialize time series of external variables.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    tasks.push_back([&]() {
+      try {
+        tab_externalInputLocations.read(control["table_externalInput_locations"], true, input_colsep, input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read locations assignment table.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    tasks.push_back([&]() {
+      try {
+        tab_initialValuesScal.read(control["table_initialValues_scal"], true, input_colsep, input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read table of scalar state variables' initial values.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    tasks.push_back([&]() {
+      try {
+        tab_initialValuesVect.read(control["table_initialValues_vect"], true, input_colsep, input_commentchar);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__, "Failed to read table of vector state variables' initial values.", __FILE__, __LINE__);
+        throw(e);
+      }
+    });
+    runTasks(tasks);
+    for (unsigned int i=0; i<shares.size(); i++) {
+      switch (shares[i].kind) {
+        case funParamsIndividual: shares[i].group->set_tableParamsFun(*shares[i].source); break;
+        case numParamsIndividual: shares[i].group->set_tableParamsNum(*shares[i].source); break;
+        case funParamsShared: shares[i].group->set_sharedParamsFun(*shares[i].source); break;
+        case numParamsShared: shares[i].group->set_sharedParamsNum(*shares[i].source); break;
+      }
+    }
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to read input data.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Initializing object outputs");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->init_outputs(tab_selectedOutput); });
+    tab_selectedOutput.clear();
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to initialize object outputs.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Switching on debug mode for selected objects");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->set_debugMode(tab_debugOutput); });
+    tab_debugOutput.clear();
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to set debug modes.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Setting times of state output");
+  try {
+    unsigned int colindex;
+    try {
+      colindex= tab_stateOutput.colindex(globalConst::colNames.time);
+    } catch (except) {
+      stringstream errmsg;
+      errmsg << "Missing column '" << globalConst::colNames.time << "' in table of state output times.";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      throw(e);
+    }
+    times_stateOutput.resize(tab_stateOutput.nrow());
+    if (tab_stateOutput.nrow() > 0) {
+      for (unsigned int i=1; i<=tab_stateOutput.nrow(); i++) {
+        times_stateOutput[i-1].set(tab_stateOutput.get_element(i,colindex));
+      }
+    }
+    tab_stateOutput.clear();
+    // Sort times (processed with a cursor in the time loop)
+    sort(times_stateOutput.begin(), times_stateOutput.end());
+    times_stateOutput.erase(unique(times_stateOutput.begin(), times_stateOutput.end()),
+      times_stateOutput.end());
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to set times of state output.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Assigning simulated inputs to objects (object linkage)");
+  try {
+    for (unsigned int m=0; m<members.size(); m++) {
+      const vector<abstractObject*> &memberObjects= members[m].objects;
+      const map<string, unsigned int> &memberIndices= members[m].objectIndices;
+      initObjects(memberObjects, singlethread_if_less_than,
+        [&](abstractObject* obj) { obj->assign_inputsSim(tab_inputOutputRelations,
+          memberObjects, memberIndices); });
+    }
+    tab_inputOutputRelations.clear();
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot assign simulated inputs to objects.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Setting object levels");
+  try {
+    for (unsigned int m=0; m<members.size(); m++) {
+      setObjectLevels(members[m].objects);
+    }
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot set object levels.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Setting up processing tree for selected objects");
+  for (unsigned int m=0; m<members.size(); m++) {
+    const vector<abstractObject*> &memberObjects= members[m].objects;
+    vector< vector<unsigned int> > &processingTree= members[m].processingTree;
+    // Allocate outer vector of processing tree (= vector of levels)
+    unsigned int maxLevel= 0;
+    unsigned int minLevel= memberObjects.size();
+    for (unsigned int i=0; i<memberObjects.size(); i++) {
+      if (memberObjects[i]->get_objectLevel() > maxLevel) {
+        maxLevel= memberObjects[i]->get_objectLevel();
+      }
+      if (memberObjects[i]->get_objectLevel() < minLevel) {
+        minLevel= memberObjects[i]->get_objectLevel();
+      }
+    }
+    processingTree.resize(maxLevel-minLevel+1);
+    // Allocate inner vectors of processing tree (= object indices of a particular level)
+    for (unsigned int i=0; i<memberObjects.size(); i++) {
+      processingTree[memberObjects[i]->get_objectLevel()-minLevel].push_back(i);
+    }
+  }
+  log("Levels for (optional) parallel processing: " +
+    as_string(members[0].processingTree.size()));
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Initializing individual parameter functions");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->init_paramsFun(input_colsep, input_commentchar); });
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to initialize individual parameter functions.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Clearing tables of individual parameter functions");
+  for (unsigned int m=0; m<members.size(); m++) {
+    for (unsigned int k=0; k<members[m].objectGroups.size(); k++) {
+      members[m].objectGroups[k]->clear_tableParamsFun();
+    }
+  }
+  // Data of the functions remain shared by the objects using them
+  tblFunction::clear_cache();
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Initializing individual scalar parameters");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->init_paramsNum(); });
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Failed to initialize individual scalar parameters.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Clearing tables of individual scalar parameters");
+  for (unsigned int m=0; m<members.size(); m++) {
+    for (unsigned int k=0; k<members[m].objectGroups.size(); k++) {
+      members[m].objectGroups[k]->clear_tableParamsNum();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Assigning external time series to objects");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->assign_inputsExt(tab_externalInputLocations, externalInputs); });
+    tab_externalInputLocations.clear();
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot assign external time series to objects.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Setting initial values of scalar state variables");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->init_statesScal(tab_initialValuesScal); });
+    tab_initialValuesScal.clear();
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot set initial values of scalar state variables.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Setting initial values of vector state variables");
+  try {
+    initObjects(objects, singlethread_if_less_than,
+      [&](abstractObject* obj) { obj->init_statesVect(tab_initialValuesVect); });
+    tab_initialValuesVect.clear();
+    for (unsigned int m=0; m<members.size(); m++) {
+      for (unsigned int k=0; k<members[m].objectGroups.size(); k++) {
+        members[m].objectGroups[k]->store_statesVect();
+      }
+    }
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot set initial values of vector state variables.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  log("Initializing simulation time");
+  try {
+    // User input
+    simStart.set(control["simStart"]);
+    simEnd.set(control["simEnd"]);
+    delta_t= as_unsigned_integer(control["delta_t"]);
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot initialize simulation time.", __FILE__, __LINE__);
+    throw(e);
+  }
+  if (simStart >= simEnd) {
+    except e(__PRETTY_FUNCTION__, "Badly defined start/end time of simulation.", __FILE__, __LINE__);
+    throw(e);
+  }
+  if (delta_t <= 0) {
+    except e(__PRETTY_FUNCTION__, "Time step must be a positive number of seconds.", __FILE__, __LINE__);
+    throw(e);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Initial states
+  try {
+    checkpoint_snapshot(simStart, objects, initialState);
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot save initial states.", __FILE__, __LINE__);
+    throw(e);
+  }
+  loaded= true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get and set methods
+////////////////////////////////////////////////////////////////////////////////
+
+fixedZoneTime simulation::get_simStart() const {
+  check_loaded(__PRETTY_FUNCTION__);
+  return(simStart);
+}
+
+fixedZoneTime simulation::get_simEnd() const {
+  check_loaded(__PRETTY_FUNCTION__);
+  return(simEnd);
+}
+
+unsigned int simulation::get_nMembers() const {
+  return(members.size());
+}
+
+void simulation::set_fileOutput(const bool enable) {
+  fileOutput= enable;
+}
+
+void simulation::set_outputSink(outputSink* sink) {
+  this->sink= sink;
+}
+
+void simulation::set_paramsNum(const string &idObjectGroup, const string &idObject,
+  const vector<double> &values, const unsigned int member)
+{
+  abstractObject* obj= get_object(__PRETTY_FUNCTION__, idObject, member);
+  if (obj->get_objectGroupPointer()->get_idObjectGroup() != idObjectGroup) {
+    stringstream errmsg;
+    errmsg << "Object with id '" << idObject << "' is not a member of object" <<
+      " group '" << idObjectGroup << "'.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  try {
+    obj->set_paramsNum(values);
+  } catch (except) {
+    stringstream errmsg;
+    errmsg << "Cannot set scalar parameters of object '" << idObject << "'.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+}
+
+vector<double> simulation::get_outputs(const string &idObject,
+  const unsigned int member) const
+{
+  unsigned int nStatesScal, nStatesVect, nOutputs;
+  const abstractObject* obj= get_object(__PRETTY_FUNCTION__, idObject, member);
+  obj->checkpoint_sizes(nStatesScal, nStatesVect, nOutputs);
+  vector<double> values(nOutputs);
+  for (unsigned int i=0; i<nOutputs; i++) {
+    values[i]= *obj->get_outputAddress(i);
+  }
+  return(values);
+}
+
+const double* simulation::get_outputAddress(const string &idObject,
+  const string &nameOutput, const unsigned int member) const
+{
+  const abstractObject* obj= get_object(__PRETTY_FUNCTION__, idObject, member);
+  const vector<string> &names= obj->get_objectGroupPointer()->get_namesOutputs();
+  for (unsigned int i=0; i<names.size(); i++) {
+    if (names[i] == nameOutput) return(obj->get_outputAddress(i));
+  }
+  stringstream errmsg;
+  errmsg << "Object '" << idObject << "' has no output named '" << nameOutput << "'.";
+  except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+  throw(e);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reset of states
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::reset_states() {
+  check_loaded(__PRETTY_FUNCTION__);
+  vector<size_t> offsets;
+  const double* values= checkpoint_values(initialState, objects, offsets);
+  for (unsigned int i=0; i<objects.size(); i++) {
+    objects[i]->checkpoint_restore(values + offsets[i]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Restart from checkpoint
+////////////////////////////////////////////////////////////////////////////////
+
+fixedZoneTime simulation::restore_checkpoint(const string &file) {
+  check_loaded(__PRETTY_FUNCTION__);
+  if (members.size() > 1) {
+    except e(__PRETTY_FUNCTION__, "Restart from a checkpoint is not supported for ensemble runs.", __FILE__, __LINE__);
+    throw(e);
+  }
+  fixedZoneTime time_restart;
+  try {
+    time_restart= checkpoint_restore(file, objects);
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot restart from checkpoint.", __FILE__, __LINE__);
+    throw(e);
+  }
+  const double seconds= time_restart.get() - simStart.get();
+  if ((time_restart <= simStart) || (time_restart >= simEnd) ||
+      (fmod(seconds, static_cast<double>(delta_t)) != 0.)) {
+    stringstream errmsg;
+    errmsg << "Time of checkpoint (" << time_restart.get("-",":"," ") <<
+      ") is not the end of a time step within the simulation period.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  return(time_restart);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Simulation of a period
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::run(const fixedZoneTime &start, const fixedZoneTime &end) {
+  check_loaded(__PRETTY_FUNCTION__);
+  if (start >= end) {
+    except e(__PRETTY_FUNCTION__, "Badly defined start/end time of simulation.", __FILE__, __LINE__);
+    throw(e);
+  }
+  if (fileOutput && fileOutput_done) {
+    except e(__PRETTY_FUNCTION__, "Output files have been written by a previous run."
+      " Disable file output for repeated runs.", __FILE__, __LINE__);
+    throw(e);
+  }
+  const int numberOfSteps= ceil((end.get() - start.get()) / delta_t);
+  stopReason.clear();
+
+  // Existing files of selected and debug output are never overwritten. This
+  // is checked before the first time step, since a run restarted from a
+  // checkpoint would otherwise fail only after the first step (the files of
+  // the previous run still exist in the output directory).
+  if (fileOutput) {
+    for (unsigned int m=0; m<members.size(); m++) {
+      try {
+        for (unsigned int i=0; i<members[m].objects.size(); i++) {
+          members[m].objects[i]->check_outputFiles(members[m].outdir, outfmt);
+        }
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Output directory '" << members[m].outdir << "' already holds" <<
+          " output files.";
+        if (start > simStart) {
+          errmsg << " A run restarted from a checkpoint writes the output of the" <<
+            " remaining period only. It requires an output directory without the" <<
+            " files of the previous run.";
+        }
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+    }
+  }
+
+  // External inputs are read sequentially from the beginning
+  if (start < timeInputs) {
+    try {
+      externalInputs.rewind();
+    } catch (except) {
+      except e(__PRETTY_FUNCTION__, "Cannot rewind time series of external variables.", __FILE__, __LINE__);
+      throw(e);
+    }
+  }
+
+  // Collection of outputs in memory
+  if (sink != NULL) {
+    try {
+      sink->begin(start, numberOfSteps);
+    } catch (except) {
+      except e(__PRETTY_FUNCTION__, "Cannot initialize collection of outputs.", __FILE__, __LINE__);
+      throw(e);
+    }
+  }
+
+  log("Simulation started");
+
+  // Output of states in background thread
+  stateWriter stateOutput(output_colsep, output_commentchar, save_checkpoints);
+  vector<fixedZoneTime>::size_type next_stateOutput=  // Cursor in 'times_stateOutput'
+    lower_bound(times_stateOutput.begin(), times_stateOutput.end(), start) -
+    times_stateOutput.begin();
+
+  // Start time loop
+  fixedZoneTime runStart= start;
+  const time_t ini= time(0);
+  int seconds_remain= 0;
+  for (int stepCounter= 1; stepCounter <= numberOfSteps; stepCounter++) {
+    fixedZoneTime stepStart= runStart + delta_t * (stepCounter -1);
+    const fixedZoneTime stepEnd= stepStart + delta_t;
+
+    // Print state
+    const unsigned int progressStepIndex= progressIndex(stepCounter, numberOfSteps, globalConst::progressSteps);
+    if (progressStepIndex < globalConst::progressSteps.size()) {   
+      stringstream msg;
+      msg << setw(2) << setfill('0') << globalConst::progressSteps[progressStepIndex] <<
+          "% done.  Computing time remaining: " << floor(seconds_remain/3600.) << "h " <<
+          setw(2) << setfill('0') << floor((seconds_remain%3600)/60.) << "m " <<
+          setw(2) << setfill('0') << (seconds_remain%60) << "s ";
+      log(msg.str());
+    }
+
+    // Update external input variables
+    try {
+      externalInputs.update(stepStart, stepEnd);
+      timeInputs= stepEnd;
+    } catch (except) {
+      stringstream errmsg;
+      errmsg << "Updating of external input variables failed in time step " <<
+        stepCounter << " of " << numberOfSteps << " starting at " <<
+        stepStart.get("-",":"," ") << ".";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      throw(e);
+    }
+
+    // Set time stamps for messages and output
+    const string stepStart_asString= stepStart.get("-",":"," ");
+    const string stepEnd_asString= stepEnd.get("-",":"," ");
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Loop over objects (spatial loop) for all ensemble members
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Members are processed in parallel, the objects of a member are then
+    // processed sequentially by the member's thread. The exceptions of a member
+    // remain with that thread until they are collected after the region.
+    if (members.size() == 1) {
+      simulateStep(members[0].objects, members[0].processingTree,
+        singlethread_if_less_than, false, trap_fpe, delta_t,
+        stepCounter, numberOfSteps, stepCounter==1,
+        stepStart_asString, stepEnd_asString,
+        fileOutput, members[0].outdir, outfmt, output_colsep);
+    } else {
+      unsigned int nExcept= 0;
+      #pragma omp parallel reduction(+:nExcept)
+      {
+      #pragma omp for schedule(dynamic)
+      for (unsigned int m=0; m<members.size(); m++) {
+        try {
+          simulateStep(members[m].objects, members[m].processingTree,
+            singlethread_if_less_than, true, trap_fpe, delta_t,
+            stepCounter, numberOfSteps, stepCounter==1,
+            stepStart_asString, stepEnd_asString,
+            fileOutput, members[m].outdir, outfmt, output_colsep);
+        } catch (except) {
+          stringstream errmsg;
+          errmsg << "Simulation failed for ensemble member '" << members[m].id << "'.";
+          except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+          nExcept++;
+        }
+      }
+      // Hand over the exceptions recorded by this thread
+      except::publish();
+      } // End of parallel region
+      except::collect();
+      if (nExcept > 0) {
+        stringstream errmsg;
+        errmsg << "Simulation failed for " << nExcept << " of " << members.size() <<
+          " ensemble member(s) in time step " << stepCounter << " of " <<
+          numberOfSteps << ".";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+    }
+
+    // Collect outputs in memory
+    if (sink != NULL) {
+      try {
+        sink->collect(stepStart, stepEnd);
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot collect outputs in time step " << stepCounter << " of " <<
+          numberOfSteps << " starting at " << stepStart_asString << ".";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+    }
+
+    // Save state (a snapshot is written in the background)
+    if (fileOutput) {
+      try {
+        while ((next_stateOutput < times_stateOutput.size()) &&
+               (times_stateOutput[next_stateOutput] < stepEnd)) {
+          next_stateOutput++;
+        }
+        if (((next_stateOutput < times_stateOutput.size()) &&
+             (times_stateOutput[next_stateOutput] == stepEnd)) ||
+            ((saveFinalState) & (stepCounter == numberOfSteps))) {
+          for (unsigned int m=0; m<members.size(); m++) {
+            stateOutput.submit(stepEnd, members[m].objects, members[m].outdir);
+          }
+        }
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot save object state at " << stepEnd_asString << ".";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+    }
+
+    // Check criteria for early termination
+    if ((stop_interval > 0) && ((stepCounter % stop_interval) == 0)) {
+      string reason;
+      bool stop;
+      try {
+        stop= check_stop(reason);
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot check criteria for early termination in time step " <<
+          stepCounter << " of " << numberOfSteps << " starting at " <<
+          stepStart_asString << ".";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+      if (stop) {
+        stopReason= reason.empty() ? "Stop criterion met." : reason;
+        stringstream msg;
+        msg << "Simulation stopped after time step " << stepCounter << " of " <<
+          numberOfSteps << " ending at " << stepEnd_asString << ": " << stopReason;
+        log(msg.str());
+        break;
+      }
+    }
+
+    // Estimate remaining computing time (for a single run)
+    seconds_remain= ceil(difftime(time(0), ini) / stepCounter *
+      (numberOfSteps - stepCounter));
+
+  } // End time loop
+  try {
+    stateOutput.finish();
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__, "Cannot save object state.", __FILE__, __LINE__);
+    throw(e);
+  }
+  log("Simulation finished");
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Close output files
+  if (fileOutput) {
+    log("Closing output files");
+    for (unsigned int i=0; i<objects.size(); i++) {
+      objects[i]->finishOutput_selected(outfmt);
+      objects[i]->closeOutput_selected();
+      objects[i]->closeOutput_debug();
+    }
+    fileOutput_done= true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Early termination
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::set_stopInterval(const unsigned int interval) {
+  stop_interval= interval;
+}
+
+void simulation::set_stopOnNonFinite(const bool enable) {
+  stop_nonFinite= enable;
+}
+
+void simulation::add_stopCriterion(const function<bool(string &reason)> &criterion) {
+  stop_criteria.push_back(criterion);
+}
+
+const string& simulation::get_stopReason() const {
+  return(stopReason);
+}
+
+bool simulation::check_stop(string &reason) const {
+  if (stop_nonFinite) {
+    string name;
+    for (unsigned int i=0; i<objects.size(); i++) {
+      if (!objects[i]->isFinite(name)) {
+        reason= "Invalid numerical value of variable '" + name + "' of object '" +
+          objects[i]->get_idObject() + "'.";
+        return(true);
+      }
+    }
+  }
+  if ((sink != NULL) && sink->limitExceeded(reason)) return(true);
+  for (unsigned int i=0; i<stop_criteria.size(); i++) {
+    if (stop_criteria[i](reason)) return(true);
+  }
+  return(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Release of data
+////////////////////////////////////////////////////////////////////////////////
+
+void simulation::clear() {
+  // The objects are owned by their object groups. They must be deleted before
+  // the external inputs which they refer to.
+  for (unsigned int m=0; m<members.size(); m++) {
+    for (unsigned int i=0; i<members[m].objectGroups.size(); i++) {
+      delete members[m].objectGroups[i];
+    }
+  }
+  members.clear();
+  objects.clear();
+  externalInputs.clear();
+  times_stateOutput.clear();
+  initialState.clear();
+  fileOutput_done= false;
+  timeInputs.set(0);
+  stopReason.clear();
+  loaded= false;
+}
+
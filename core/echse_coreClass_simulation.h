@@ -0,0 +1,164 @@
+#ifndef ECHSE_CORECLASS_SIMULATION_H
+#define ECHSE_CORECLASS_SIMULATION_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+#include "except/except.h"
+#include "logfile/logfile.h"
+#include "settings/settings.h"
+#include "fixedZoneTime/fixedZoneTime.h"
+
+#include "echse_coreClass_abstractObject.h"
+#include "echse_coreClass_abstractObjectGroup.h"
+#include "echse_coreClass_spaceTimeDataCollection.h"
+#include "echse_coreClass_outputSink.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'simulation'
+//
+// A model set up according to a control file. The model is loaded once (object
+// instantiation, input data, initialization) and can then be simulated
+// repeatedly, e.g. by a calibration driver linked against the engine:
+//
+//   simulation sim;
+//   sim.load(control, NULL, true);
+//   sim.set_fileOutput(false);
+//   for (...) {
+//     sim.set_paramsNum("groupID", "objectID", values);
+//     sim.reset_states();
+//     sim.run(sim.get_simStart(), sim.get_simEnd());
+//     ... sim.get_outputs("objectID") ...
+//   }
+//
+// Notes:
+//   - The states are not reset by 'run'. Calling 'run' for consecutive periods
+//     continues the simulation.
+//   - External inputs are read sequentially. If a run starts before the end
+//     of the previous run, the input files are rewound. To avoid file access
+//     in repeated runs, the buffer size of the external inputs should exceed
+//     the number of records in the files.
+//   - Files of selected outputs, debug outputs, and states are written by one
+//     run only. Repeated runs require 'set_fileOutput(false)'.
+//   - Selected outputs can be collected in memory and compared against
+//     observations by an 'outputSink' (see 'set_outputSink').
+//   - A run can be stopped early if it is hopeless (e.g. in calibration, see
+//     'set_stopInterval'). The criteria are checked every N time steps only.
+//   - Objects of all ensemble members are held. Methods accessing a particular
+//     object refer to member 0 unless a member index is given.
+////////////////////////////////////////////////////////////////////////////////
+
+class simulation {
+  private:
+    // Members of an ensemble: Each member holds a complete set of objects with
+    // states and outputs of its own. Data which are read-only during the
+    // simulation (external inputs, function tables, tables used for
+    // initialization) are shared by all members. A normal run is an ensemble
+    // with a single member.
+    struct T_member {
+      string id;                                // Empty if not an ensemble run
+      string outdir;                            // Output directory
+      map<string, string> files;                // Member-specific files (key of control file --> file)
+      vector<abstractObjectGroup*> objectGroups;
+      vector<abstractObject*> objects;
+      map<string, unsigned int> objectIndices;  // Object ID --> index in 'objects'
+      // Vector controlling the order of processing
+      // Outer vector: Levels
+      // Inner vectors: Indices of the objects of a particular level
+      vector< vector<unsigned int> > processingTree;
+    };
+    vector<T_member> members;
+    vector<abstractObject*> objects;            // Objects of all members
+    spaceTimeDataCollection externalInputs;
+    vector<fixedZoneTime> times_stateOutput;
+    // Settings
+    string output_colsep, output_commentchar;
+    string outdir, outfmt;
+    unsigned int singlethread_if_less_than;
+    bool trap_fpe;
+    bool check_range;
+    bool saveFinalState;
+    bool save_checkpoints;
+    fixedZoneTime simStart, simEnd;
+    unsigned int delta_t;
+    // Status
+    bool loaded;
+    bool fileOutput;
+    bool fileOutput_done;
+    fixedZoneTime timeInputs;                   // End of the last update of external inputs
+    vector<char> initialState;                  // Snapshot of the initial states (see 'checkpoint_snapshot')
+    outputSink* sink;                           // Collection of outputs in memory (optional)
+    // Early termination
+    unsigned int stop_interval;                 // Check every N time steps (0: never)
+    bool stop_nonFinite;
+    vector< function<bool(string&)> > stop_criteria;
+    string stopReason;                          // Empty if the last run was completed
+    // Logging
+    logfile* lg;
+    bool silent;
+    void log(const string &message);
+    // Methods
+    void check_loaded(const char* func) const;
+    abstractObject* get_object(const char* func, const string &idObject,
+      const unsigned int member) const;
+    bool check_stop(string &reason) const;
+    // Don't allow assignment or copy construction (made private + not implemented)
+    simulation& operator=(const simulation &x);
+    simulation(const simulation &x);
+  public:
+    // Ctor & dtor
+    simulation();
+    ~simulation();
+    // Set up the model as specified by the control data. Messages are written
+    // to the log file if 'lg' is not NULL.
+    void load(const settings &control, logfile* lg, const bool silent);
+    // Query the simulation period of the control data
+    fixedZoneTime get_simStart() const;
+    fixedZoneTime get_simEnd() const;
+    unsigned int get_nMembers() const;
+    // Enable/disable output to files (enabled by default)
+    void set_fileOutput(const bool enable);
+    // Set the collection of outputs in memory (NULL for none). The sink must
+    // exist as long as it is set.
+    void set_outputSink(outputSink* sink);
+    // Early termination of runs: The stop criteria are checked every 'interval'
+    // time steps (0 disables all checks). A run is stopped if
+    //   - a state or output of any object is not finite (if enabled),
+    //   - a limit set in the output sink is exceeded (see 'outputSink'),
+    //   - a user-defined criterion returns true (e.g. a model-specific check of
+    //     the mass balance). The criterion sets the reason of the stop.
+    void set_stopInterval(const unsigned int interval);
+    void set_stopOnNonFinite(const bool enable);
+    void add_stopCriterion(const function<bool(string &reason)> &criterion);
+    // Reason why the last run was stopped early (empty if completed)
+    const string& get_stopReason() const;
+    // Replace the individual scalar parameters of an object
+    void set_paramsNum(const string &idObjectGroup, const string &idObject,
+      const vector<double> &values, const unsigned int member=0);
+    // Reset the states and outputs of all objects to the initial values
+    void reset_states();
+    // Restore the states and outputs of all objects from a checkpoint file.
+    // Returns the time of the checkpoint.
+    fixedZoneTime restore_checkpoint(const string &file);
+    // Simulate the period from 'start' to 'end'
+    void run(const fixedZoneTime &start, const fixedZoneTime &end);
+    // Current values of all outputs of an object (in the order of the output
+    // names of the object group)
+    vector<double> get_outputs(const string &idObject, const unsigned int member=0) const;
+    // Address of an output of an object (e.g. for 'outputSink::add')
+    const double* get_outputAddress(const string &idObject, const string &nameOutput,
+      const unsigned int member=0) const;
+    // Release all data (objects, object groups, inputs). Afterwards, a model
+    // can be loaded again. Addresses obtained from 'get_outputAddress' become
+    // invalid.
+    void clear();
+};
+
+#endif
+
@@ -0,0 +1,109 @@
+#ifndef ECHSE_CORECLASS_SIZEDOBJECT_H
+#define ECHSE_CORECLASS_SIZEDOBJECT_H
+
+#include <array>
+#include <sstream>
+#include <string>
+
+#include "except/except.h"
+
+#include "echse_coreClass_abstractObject.h"
+#include "echse_coreClass_objectAccess.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Class template 'sizedObject'
+//
+// Optional base class for object classes whose numbers of individual scalar
+// parameters, simulated inputs, and outputs are known at compile time (i.e.
+// classes created by the code generator). These items are stored in arrays of
+// fixed size inside the object itself rather than in vectors on the heap. The
+// access methods defined here hide those of 'objectAccess'. Together with
+// index constants declared as 'constexpr', an access in 'simulate()' or
+// 'derivsScal()' is a load at a constant offset from 'this', which can be
+// inlined without any pointer indirection.
+//
+// Usage: A class is derived as
+//   class myClass : public sizedObject<NPARAMSNUM, NINPUTSSIM, NOUTPUTS>
+// instead of
+//   class myClass : public abstractObject
+// where the template arguments are the lengths of the name vectors passed to
+// the constructor of the object group. A mismatch is detected when the storage
+// is allocated during initialization. Like 'abstractObject', the name
+// 'sizedObject' with three arguments refers to an alias in the namespaces of
+// the model variants, which supplies the leading argument CHECKED (see
+// 'echse_coreClass_objectAccess.h' and 'echse_coreFunct_modelVariants.h').
+//
+// Note: Scalar state variables are still held in a vector since the ODE solver
+// interface works on 'stateScal_all()' and 'set_stateScal_all()'.
+////////////////////////////////////////////////////////////////////////////////
+
+template<bool CHECKED, unsigned int NPARAMSNUM, unsigned int NINPUTSSIM,
+  unsigned int NOUTPUTS>
+class sizedObject : public objectAccess<CHECKED> {
+  private:
+    array<double, NPARAMSNUM> fixed_paramsNum;
+    array<const double*, NINPUTSSIM> fixed_inputsSim;
+    array<double, NOUTPUTS> fixed_outputs;
+    // Check of the requested number of items against the compile-time size
+    void check_size(const unsigned int n, const unsigned int nfixed,
+      const string &what) const {
+      if (n != nfixed) {
+        stringstream errmsg;
+        errmsg << "Object '" << this->get_idObject() << "' of object group '" <<
+          this->get_objectGroupPointer()->get_idObjectGroup() << "' was compiled for " <<
+          nfixed << " " << what << " but the object group declares " << n << ".";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        throw(e);
+      }
+    }
+  protected:
+    // Redefined allocation methods of the base class
+    void allocate_paramsNum(const unsigned int n) {
+      check_size(n, NPARAMSNUM, "individual scalar parameters");
+      fixed_paramsNum.fill(0.);
+      this->bind_paramsNum(fixed_paramsNum.data(), n);
+    }
+    void allocate_inputsSim(const unsigned int n) {
+      check_size(n, NINPUTSSIM, "simulated inputs");
+      fixed_inputsSim.fill(NULL);
+      this->bind_inputsSim(fixed_inputsSim.data(), n);
+    }
+    void allocate_outputs(const unsigned int n) {
+      check_size(n, NOUTPUTS, "outputs");
+      fixed_outputs.fill(0.);
+      this->bind_outputs(fixed_outputs.data(), n);
+    }
+    // FULL access to outputs (hides the base class method)
+    double& set_output(const T_index_output &index) {
+      if (CHECKED && (index.index >= NOUTPUTS))
+        this->error_indexRange(__PRETTY_FUNCTION__, "output variable", index.index, NOUTPUTS);
+      return(fixed_outputs[index.index]);
+    }
+  public:
+    // Constructor
+    sizedObject() {
+      fixed_paramsNum.fill(0.);
+      fixed_inputsSim.fill(NULL);
+      fixed_outputs.fill(0.);
+    }
+    // READ-ONLY access (hides the base class methods)
+    double paramNum(const T_index_paramNum &index) const {
+      if (CHECKED && (index.index >= NPARAMSNUM))
+        this->error_indexRange(__PRETTY_FUNCTION__, "individual scalar parameter", index.index, NPARAMSNUM);
+      return(fixed_paramsNum[index.index]);
+    }
+    double inputSim(const T_index_inputSim &index) const {
+      if (CHECKED && (index.index >= NINPUTSSIM))
+        this->error_indexRange(__PRETTY_FUNCTION__, "simulated input variable", index.index, NINPUTSSIM);
+      return(*fixed_inputsSim[index.index]);
+    }
+    double output(const T_index_output &index) const {
+      if (CHECKED && (index.index >= NOUTPUTS))
+        this->error_indexRange(__PRETTY_FUNCTION__, "output variable", index.index, NOUTPUTS);
+      return(fixed_outputs[index.index]);
+    }
+};
+
+#endif
@@ -221,3 +221,20 @@ void spaceTimeDataCollection::update(const fixedZoneTime &timeStart, const fixed
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Rewind method
+////////////////////////////////////////////////////////////////////////////////
+
+void spaceTimeDataCollection::rewind() const {
+  for (unsigned int i=0; i<dataPointers.size(); i++) {
+    try {
+      dataPointers[i]->rewind();
+    } catch (except) {
+      stringstream errmsg;
+      errmsg << "Cannot rewind data of variable '" << variableNames[i] << "'.";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+  }
+}
+
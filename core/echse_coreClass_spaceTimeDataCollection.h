@@ -41,6 +41,7 @@ class spaceTimeDataCollection {
       const unsigned int indexLocation) const;
     void update(const fixedZoneTime &timeStart,
       const fixedZoneTime &timeEnd) const;
+    void rewind() const;
     void clear();
 };
 
@@ -0,0 +1,139 @@
+
+#include "echse_coreClass_stateWriter.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Ctor
+////////////////////////////////////////////////////////////////////////////////
+
+stateWriter::stateWriter(const string &chars_colsep, const string &chars_comment,
+  const bool checkpoints) :
+  chars_colsep(chars_colsep), chars_comment(chars_comment),
+  checkpoints(checkpoints)
+{
+  busy= false;
+  stopping= false;
+  failed= false;
+  worker= thread(&stateWriter::run, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Dtor
+////////////////////////////////////////////////////////////////////////////////
+
+stateWriter::~stateWriter() {
+  {
+    lock_guard<mutex> lock(jobs_mutex);
+    stopping= true;
+  }
+  jobs_added.notify_one();
+  if (worker.joinable()) worker.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Processing of snapshots (background thread)
+////////////////////////////////////////////////////////////////////////////////
+
+void stateWriter::run() {
+  T_job job;
+  bool skip;
+  while (true) {
+    {
+      unique_lock<mutex> lock(jobs_mutex);
+      jobs_added.wait(lock, [this]{ return(stopping || !jobs.empty()); });
+      if (jobs.empty()) return;  // Stopping and nothing left to do
+      job.time= jobs.front().time;
+      job.objects= jobs.front().objects;
+      job.outdir= jobs.front().outdir;
+      job.snapshot.swap(jobs.front().snapshot);
+      jobs.pop_front();
+      busy= true;
+      skip= failed;
+    }
+    jobs_removed.notify_all();
+    // Write (after the first failure, remaining snapshots are discarded)
+    bool ok= true;
+    if (!skip) {
+      try {
+        saveState(job.outdir, job.time, chars_colsep, chars_comment,
+          *job.objects, job.snapshot);
+        if (checkpoints) saveCheckpoint(job.outdir, job.time, job.snapshot);
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Cannot save object state at " << job.time.get("-",":"," ") <<
+          " (output directory '" << job.outdir << "').";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        // Hand over the exceptions recorded by this thread
+        except::publish();
+        ok= false;
+      } catch (...) {
+        // Standard/system exceptions must not escape the thread function (this
+        // would terminate the program without a traceback)
+        stringstream errmsg;
+        errmsg << "Cannot save object state at " << job.time.get("-",":"," ") <<
+          " (output directory '" << job.outdir << "'). Standard/system exception" <<
+          " (e.g. memory allocation or file output failed).";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        except::publish();
+        ok= false;
+      }
+    }
+    {
+      lock_guard<mutex> lock(jobs_mutex);
+      if (!ok) failed= true;
+      busy= false;
+    }
+    jobs_removed.notify_all();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Report failure of the background thread (calling thread)
+////////////////////////////////////////////////////////////////////////////////
+
+void stateWriter::throw_ifFailed(const char* func) {
+  bool f;
+  {
+    lock_guard<mutex> lock(jobs_mutex);
+    f= failed;
+  }
+  if (f) {
+    except::collect();
+    except e(func, "Output of object states failed.", __FILE__, __LINE__);
+    throw(e);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Queue a snapshot (calling thread)
+////////////////////////////////////////////////////////////////////////////////
+
+void stateWriter::submit(const fixedZoneTime &time,
+  const vector<abstractObject*> &objects, const string &outdir) {
+  throw_ifFailed(__PRETTY_FUNCTION__);
+  T_job job;
+  job.time= time;
+  checkpoint_snapshot(time, objects, job.snapshot);
+  {
+    unique_lock<mutex> lock(jobs_mutex);
+    jobs_removed.wait(lock, [this]{ return(failed || (jobs.size() < maxPending)); });
+    jobs.push_back(T_job());
+    jobs.back().time= job.time;
+    jobs.back().objects= &objects;
+    jobs.back().outdir= outdir;
+    jobs.back().snapshot.swap(job.snapshot);
+  }
+  jobs_added.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Wait for completion (calling thread)
+////////////////////////////////////////////////////////////////////////////////
+
+void stateWriter::finish() {
+  {
+    unique_lock<mutex> lock(jobs_mutex);
+    jobs_removed.wait(lock, [this]{ return(jobs.empty() && !busy); });
+  }
+  throw_ifFailed(__PRETTY_FUNCTION__);
+}
+
@@ -0,0 +1,79 @@
+#ifndef ECHSE_CORECLASS_STATEWRITER_H
+#define ECHSE_CORECLASS_STATEWRITER_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "except/except.h"
+#include "fixedZoneTime/fixedZoneTime.h"
+
+#include "echse_coreClass_abstractObject.h"
+#include "echse_coreFunct_saveState.h"
+#include "echse_coreFunct_checkpoint.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Class 'stateWriter'
+//
+// Writes the states of a set of objects (text tables, see 'saveState') and,
+// optionally, binary checkpoints in a background thread. A single writer can
+// serve multiple sets of objects (e.g. the members of an ensemble) with
+// different output directories. The calling thread only takes a snapshot of
+// the objects' data (see 'checkpoint_snapshot'), so that the time loop is not
+// stalled by formatting and file output.
+// At most 'maxPending' snapshots are queued. If the writer falls behind, the
+// calling thread waits until a snapshot has been written.
+// Failures in the background thread are reported by the next call of
+// submit() or finish() in the calling thread.
+////////////////////////////////////////////////////////////////////////////////
+
+class stateWriter {
+  private:
+    // Snapshot to be written
+    struct T_job {
+      fixedZoneTime time;
+      const vector<abstractObject*>* objects;
+      string outdir;
+      vector<char> snapshot;
+    };
+    static const unsigned int maxPending= 2;
+    // Settings
+    const string chars_colsep;
+    const string chars_comment;
+    const bool checkpoints;
+    // Queue and synchronization
+    deque<T_job> jobs;
+    mutex jobs_mutex;
+    condition_variable jobs_added;
+    condition_variable jobs_removed;
+    bool busy;
+    bool stopping;
+    bool failed;
+    thread worker;
+    // Methods
+    void run();
+    void throw_ifFailed(const char* func);
+    // Don't allow assignment or copy construction (made private + not implemented)
+    stateWriter& operator=(const stateWriter &x);
+    stateWriter(const stateWriter &x);
+  public:
+    // Ctor & dtor (the destructor waits until all pending snapshots are written)
+    stateWriter(const string &chars_colsep, const string &chars_comment,
+      const bool checkpoints);
+    ~stateWriter();
+    // Take a snapshot of the objects and queue it for writing to 'outdir'. The
+    // objects must exist until the snapshot has been written.
+    void submit(const fixedZoneTime &time, const vector<abstractObject*> &objects,
+      const string &outdir);
+    // Wait until all snapshots are written
+    void finish();
+};
+
+#endif
+
@@ -40,10 +40,10 @@ class templateObjectGroup: public abstractObjectGroup {
       const vector<string> namesSharedParamsFun,
       const vector<string> namesSharedParamsNum
     ) {
-      if (n_instances == 1) {
+      if (n_instances == abstractObjectGroup::maxInstances) {
         stringstream errmsg;
-        errmsg << "Attempt to instantiate more than one object group" <<
-          " with id '" << id << "'.";
+        errmsg << "Attempt to instantiate more than " << abstractObjectGroup::maxInstances <<
+          " object group(s) with id '" << id << "'.";
         except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
         throw(e);
       }
@@ -61,14 +61,17 @@ class templateObjectGroup: public abstractObjectGroup {
         abstractObjectGroup::set_namesStatesVect(namesStatesVect);
         abstractObjectGroup::set_namesOutputs(namesOutputs);
       } catch (except) {
+        n_instances--;  // Destructor is not called for incomplete objects
         stringstream errmsg;
         errmsg << "Failed to set item names for object group with id '" << id << "'.";
         except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
         throw(e);
       }
     }
-    // Destructor
-    ~templateObjectGroup() { };
+    // Destructor (the group can be instantiated again, e.g. by reloading a model)
+    ~templateObjectGroup() {
+      n_instances--;
+    };
     // Redefined methods of the abstract base class
     void addObject(const string idObject) {
       abstractObjectGroup::size_type n;
@@ -76,7 +79,7 @@ class templateObjectGroup: public abstractObjectGroup {
       objects.resize(n+1);
       static_cast<abstractObject*>(&objects[n])->set_idObject(idObject);
       static_cast<abstractObject*>(&objects[n])->set_objectGroupPointer(
-        static_cast<abstractObjectGroup*>(this));
+        static_cast<abstractObjectGroup*>(this), n);
     }
     unsigned int numObjects() const {
       return(objects.size());
@@ -0,0 +1,280 @@
+
+#include "echse_coreFunct_checkpoint.h"
+
+namespace {
+
+  // Constants of the file format
+  const char MAGIC[8]= {'E','C','H','S','E','C','K','P'};
+  const unsigned int VERSION= 1;
+  const unsigned int BYTEORDER= 0x01020304;
+
+  // Append the bytes of a value to a buffer
+  template <class T>
+  void append(vector<char> &buffer, const T &value) {
+    const char* p= reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+  }
+
+  // Pad a buffer with zeros so that the array of doubles is aligned
+  void align(vector<char> &buffer) {
+    buffer.resize(buffer.size() + (sizeof(double) - buffer.size() % sizeof(double)) %
+      sizeof(double), 0);
+  }
+
+  // Sequential reading from a buffer with checks of the remaining size
+  class bufferReader {
+    private:
+      const vector<char> &buffer;
+      const string &file;
+      size_t pos;
+    public:
+      bufferReader(const vector<char> &buffer, const string &file) :
+        buffer(buffer), file(file), pos(0) { }
+      const char* take(const size_t n) {
+        if (n > (buffer.size() - pos)) {
+          stringstream errmsg;
+          errmsg << "Unexpected end of checkpoint file '" << file << "'.";
+          except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+          throw(e);
+        }
+        const char* p= buffer.data() + pos;
+        pos+= n;
+        return(p);
+      }
+      template <class T>
+      T get() {
+        T value;
+        memcpy(&value, take(sizeof(T)), sizeof(T));
+        return(value);
+      }
+      void align() {
+        take((sizeof(double) - pos % sizeof(double)) % sizeof(double));
+      }
+  };
+
+} // End of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Snapshot of the dynamic data of all objects
+////////////////////////////////////////////////////////////////////////////////
+
+void checkpoint_snapshot(
+  const fixedZoneTime &time,
+  const vector<abstractObject*> &objects,
+  vector<char> &buffer
+) {
+  unsigned int nStatesScal, nStatesVect, nOutputs;
+  vector<size_t> offsets(objects.size() + 1);
+  buffer.clear();
+  // Header
+  buffer.insert(buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+  append(buffer, VERSION);
+  append(buffer, BYTEORDER);
+  append(buffer, time.get());
+  append(buffer, static_cast<unsigned int>(objects.size()));
+  // Catalog
+  offsets[0]= 0;
+  for (unsigned int i=0; i<objects.size(); i++) {
+    const string id= objects[i]->get_idObject();
+    append(buffer, static_cast<unsigned int>(id.size()));
+    buffer.insert(buffer.end(), id.begin(), id.end());
+    objects[i]->checkpoint_sizes(nStatesScal, nStatesVect, nOutputs);
+    append(buffer, nStatesScal);
+    append(buffer, nStatesVect);
+    append(buffer, nOutputs);
+    offsets[i+1]= offsets[i] + nStatesScal + nStatesVect + nOutputs;
+  }
+  align(buffer);
+  // Data
+  const size_t start= buffer.size();
+  try {
+    buffer.resize(start + offsets.back() * sizeof(double));
+  } catch (const bad_alloc&) {
+    stringstream errmsg;
+    errmsg << "Cannot allocate buffer for checkpoint of " << offsets.back() <<
+      " values at " << time.get("-",":"," ") << ".";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  double* data= reinterpret_cast<double*>(buffer.data() + start);
+  for (unsigned int i=0; i<objects.size(); i++) {
+    objects[i]->checkpoint_save(data + offsets[i]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Access to the values of a snapshot
+////////////////////////////////////////////////////////////////////////////////
+
+const double* checkpoint_values(
+  const vector<char> &buffer,
+  const vector<abstractObject*> &objects,
+  vector<size_t> &offsets
+) {
+  offsets.resize(objects.size() + 1);
+  offsets[0]= 0;
+  for (unsigned int i=0; i<objects.size(); i++) {
+    offsets[i+1]= offsets[i] + objects[i]->checkpoint_size();
+  }
+  // The values are stored at the end of the buffer
+  if ((offsets.back() * sizeof(double)) > buffer.size()) {
+    except e(__PRETTY_FUNCTION__,"Snapshot does not match the objects.",__FILE__,__LINE__);
+    throw(e);
+  }
+  return(reinterpret_cast<const double*>(buffer.data() + buffer.size() -
+    offsets.back() * sizeof(double)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Writing of a snapshot to file
+////////////////////////////////////////////////////////////////////////////////
+
+void checkpoint_write(
+  const string &file,
+  const vector<char> &buffer
+) {
+  if (file_exists(file)) {
+    stringstream errmsg;
+    errmsg << "Cannot write checkpoint to file '" << file <<
+      "'. File already exists.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  const string file_tmp= file + ".tmp";
+  ofstream ost(file_tmp.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!ost.is_open()) {
+    stringstream errmsg;
+    errmsg << "Cannot write checkpoint to file '" << file_tmp <<
+      "'. File cannot be opened.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  ost.write(buffer.data(), buffer.size());
+  ost.close();
+  if (ost.fail()) {
+    remove(file_tmp.c_str());
+    stringstream errmsg;
+    errmsg << "Cannot write checkpoint to file '" << file_tmp <<
+      "'. Writing failed (disk full?).";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  if (rename(file_tmp.c_str(), file.c_str()) != 0) {
+    stringstream errmsg;
+    errmsg << "Cannot rename temporary checkpoint file '" << file_tmp <<
+      "' to '" << file << "'.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Checkpoint in the output directory
+////////////////////////////////////////////////////////////////////////////////
+
+void saveCheckpoint(
+  const string &outdir,
+  const fixedZoneTime &now,
+  const vector<char> &buffer
+) {
+  checkpoint_write(outdir + "/" + "checkpoint" + "_" + now.get("","","") +
+    globalConst::fileExtensions.checkpoint, buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Restoring of the dynamic data of all objects
+////////////////////////////////////////////////////////////////////////////////
+
+fixedZoneTime checkpoint_restore(
+  const string &file,
+  const vector<abstractObject*> &objects
+) {
+  unsigned int nStatesScal, nStatesVect, nOutputs;
+  vector<size_t> offsets(objects.size() + 1);
+  vector<char> buffer;
+  // Read entire file
+  ifstream ist(file.c_str(), ios::in | ios::binary);
+  if (!ist.is_open()) {
+    stringstream errmsg;
+    errmsg << "Cannot read checkpoint from file '" << file <<
+      "'. File cannot be opened.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  ist.seekg(0, ios::end);
+  const streamoff size= ist.tellg();
+  ist.seekg(0, ios::beg);
+  try {
+    buffer.resize(size);
+  } catch (const bad_alloc&) {
+    stringstream errmsg;
+    errmsg << "Cannot allocate buffer to read checkpoint file '" << file << "'.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  ist.read(buffer.data(), size);
+  if (ist.fail()) {
+    stringstream errmsg;
+    errmsg << "Cannot read checkpoint from file '" << file << "'.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  ist.close();
+  // Header
+  bufferReader rd(buffer, file);
+  if (memcmp(rd.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+    stringstream errmsg;
+    errmsg << "File '" << file << "' is not a checkpoint file.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  const unsigned int version= rd.get<unsigned int>();
+  const unsigned int byteorder= rd.get<unsigned int>();
+  if ((version != VERSION) || (byteorder != BYTEORDER)) {
+    stringstream errmsg;
+    errmsg << "Checkpoint file '" << file << "' was written by an incompatible" <<
+      " version of the program or on a machine with different byte order.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  const fixedZoneTime time(rd.get<double>());
+  const unsigned int nObjects= rd.get<unsigned int>();
+  if (nObjects != objects.size()) {
+    stringstream errmsg;
+    errmsg << "Checkpoint file '" << file << "' holds data of " << nObjects <<
+      " object(s) but the model has " << objects.size() << " object(s).";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  // Catalog (objects must match in order and size)
+  offsets[0]= 0;
+  for (unsigned int i=0; i<objects.size(); i++) {
+    const unsigned int len= rd.get<unsigned int>();
+    const char* id= rd.take(len);
+    const unsigned int nsc= rd.get<unsigned int>();
+    const unsigned int nsv= rd.get<unsigned int>();
+    const unsigned int nou= rd.get<unsigned int>();
+    objects[i]->checkpoint_sizes(nStatesScal, nStatesVect, nOutputs);
+    if ((objects[i]->get_idObject() != string(id, len)) ||
+        (nsc != nStatesScal) || (nsv != nStatesVect) || (nou != nOutputs)) {
+      stringstream errmsg;
+      errmsg << "Data for object '" << string(id, len) << "' in checkpoint file '" <<
+        file << "' do not match object '" << objects[i]->get_idObject() <<
+        "' of the model (object " << (i+1) << "). Scalar states, values of" <<
+        " vector states, outputs: " << nsc << ", " << nsv << ", " << nou <<
+        " (file) versus " << nStatesScal << ", " << nStatesVect << ", " <<
+        nOutputs << " (model).";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+    offsets[i+1]= offsets[i] + nsc + nsv + nou;
+  }
+  rd.align();
+  // Data
+  const double* data= reinterpret_cast<const double*>(rd.take(offsets.back() * sizeof(double)));
+  for (unsigned int i=0; i<objects.size(); i++) {
+    objects[i]->checkpoint_restore(data + offsets[i]);
+  }
+  return(time);
+}
+
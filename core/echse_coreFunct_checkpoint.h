@@ -0,0 +1,86 @@
+#ifndef ECHSE_COREFUNCT_CHECKPOINT_H
+#define ECHSE_COREFUNCT_CHECKPOINT_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <new>
+
+#include "except/except.h"
+#include "typeconv/typeconv.h"
+#include "fixedZoneTime/fixedZoneTime.h"
+#include "system/system.h"
+
+#include "echse_coreClass_abstractObject.h"
+#include "echse_globalConst.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Binary checkpoints
+//
+// A checkpoint holds the dynamic data of all objects (scalar states, vector
+// states, and outputs) at the end of a time step. Layout of a file:
+//   Header:  "ECHSECKP", format version, byte order mark, time (unix time),
+//            number of objects
+//   Catalog: For each object: length of ID, ID, number of scalar states,
+//            number of values of vector states, number of outputs
+//   Data:    Values of all objects as one contiguous array of doubles
+// The file is written in the native byte order, i.e. checkpoints can only be
+// used on machines of the same architecture. The byte order mark is checked
+// when a checkpoint is read.
+//
+// Note: Data which do not need to be stored:
+//   - The external input data are re-positioned by time when the first time
+//     step after a restart is processed.
+//   - The ODE solvers do not keep a state between time steps.
+////////////////////////////////////////////////////////////////////////////////
+
+// Copy the data of all objects into a buffer in the checkpoint format
+void checkpoint_snapshot(
+  const fixedZoneTime &time,
+  const vector<abstractObject*> &objects,
+  vector<char> &buffer
+);
+
+// Access to the values in a buffer created by 'checkpoint_snapshot' for the
+// same objects. Returns the start of the array of values. On return, the
+// values of object i start at position offsets[i] of that array (see
+// 'abstractObject::checkpoint_save' for the order of values).
+const double* checkpoint_values(
+  const vector<char> &buffer,
+  const vector<abstractObject*> &objects,
+  vector<size_t> &offsets
+);
+
+// Write a buffer created by 'checkpoint_snapshot' to a new file. The buffer is
+// written by a single sequential write to a temporary file which is renamed
+// afterwards, so that a file with the final name is always complete.
+void checkpoint_write(
+  const string &file,
+  const vector<char> &buffer
+);
+
+// Write a buffer created by 'checkpoint_snapshot' to the output directory
+// (file name derived from the time)
+void saveCheckpoint(
+  const string &outdir,
+  const fixedZoneTime &now,
+  const vector<char> &buffer
+);
+
+// Restore the data of all objects from a checkpoint file. The objects must be
+// initialized (incl. initial values of states) with the same configuration
+// as used for the run which created the checkpoint. Returns the time of the
+// checkpoint.
+fixedZoneTime checkpoint_restore(
+  const string &file,
+  const vector<abstractObject*> &objects
+);
+
+#endif
+
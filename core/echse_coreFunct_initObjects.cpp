@@ -0,0 +1,41 @@
+#include "echse_coreFunct_initObjects.h"
+
+void runTasks(const vector< function<void()> > &tasks) {
+  unsigned int nExcept= 0;
+  #pragma omp parallel
+  {
+    #pragma omp single
+    {
+      for (unsigned int i=0; i<tasks.size(); i++) {
+        #pragma omp task firstprivate(i) shared(tasks, nExcept)
+        {
+          try {
+            tasks[i]();
+          } catch (except) {
+            #pragma omp atomic
+            nExcept++;
+          } catch (...) {
+            // Standard/system exceptions must not escape the task (this would
+            // terminate the program without a traceback)
+            stringstream errmsg;
+            errmsg << "Task " << (i+1) << " of " << tasks.size() << " failed due" <<
+              " to a standard/system exception (e.g. memory allocation or file" <<
+              " input failed).";
+            except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+            #pragma omp atomic
+            nExcept++;
+          }
+        }
+      }
+    } // Implicit barrier: all tasks are completed here
+    // Hand over the exceptions recorded by this thread
+    except::publish();
+  } // End of parallel region
+  except::collect();
+  if (nExcept > 0) {
+    stringstream errmsg;
+    errmsg << nExcept << " of " << tasks.size() << " task(s) failed.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+}
@@ -0,0 +1,80 @@
+
+#ifndef ECHSE_COREFUNCT_INITOBJECTS_H
+#define ECHSE_COREFUNCT_INITOBJECTS_H
+
+#include <sstream>
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "except/except.h"
+#include "echse_coreClass_abstractObject.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Applies an initialization method to all objects
+////////////////////////////////////////////////////////////////////////////////
+
+// The function 'init' is called as init(objects[i]) for all objects. The calls
+// are processed in parallel if the number of objects is at least
+// 'singlethread_if_less_than'. Hence, 'init' must only modify the object passed
+// to it and must access shared data (e.g. tables) read-only.
+// Like in the simulation loop, exceptions are recorded by each thread and
+// merged after the parallel region. Processing continues if the
+// initialization of an object fails, so that all bad objects are reported.
+// If any object failed, an exception is thrown after all objects have been
+// processed.
+
+template <class F>
+void initObjects(const vector<abstractObject*> &objects,
+  const unsigned int singlethread_if_less_than, F init)
+{
+  unsigned int nExcept= 0;
+  #pragma omp parallel if(objects.size() >= singlethread_if_less_than) reduction(+:nExcept)
+  {
+  #pragma omp for schedule(dynamic, 64)
+  for (unsigned int i=0; i<objects.size(); i++) {
+    try {
+      init(objects[i]);
+    } catch (except) {
+      stringstream errmsg;
+      errmsg << "Initialization failed for object '" << objects[i]->get_idObject() << "'.";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      nExcept++;
+    } catch (...) {
+      // Standard/system exceptions must not escape the parallel region (this
+      // would terminate the program without a traceback)
+      stringstream errmsg;
+      errmsg << "Initialization failed for object '" << objects[i]->get_idObject() <<
+        "' due to a standard/system exception (e.g. memory allocation or file" <<
+        " input failed).";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      nExcept++;
+    }
+  }
+  // Hand over the exceptions recorded by this thread
+  except::publish();
+  } // End of parallel region
+  except::collect();
+  if (nExcept > 0) {
+    stringstream errmsg;
+    errmsg << "Initialization failed for " << nExcept << " of " << objects.size() <<
+      " object(s).";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Runs independent tasks concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+// Each task is processed as an OpenMP task. The tasks must not depend on each
+// other. Exceptions are handled as in 'initObjects', i.e. all tasks are
+// completed before an exception is thrown.
+
+void runTasks(const vector< function<void()> > &tasks);
+
+#endif
+
@@ -106,3 +106,27 @@ void instantiateObjects(
   }
 }
 
+void instantiateObjects(
+  const vector<abstractObjectGroup*> &objectGroups_template,
+  vector<abstractObjectGroup*> &objectGroups,
+  vector<abstractObject*> &objects
+) {
+  if (objectGroups.size() != objectGroups_template.size()) {
+    except e(__PRETTY_FUNCTION__, "Number of object groups does not match.", __FILE__, __LINE__);
+    throw(e);
+  }
+  objects.clear();
+  for (unsigned int k=0; k<objectGroups.size(); k++) {
+    if (objectGroups[k]->get_idObjectGroup() != objectGroups_template[k]->get_idObjectGroup()) {
+      except e(__PRETTY_FUNCTION__, "Order of object groups does not match.", __FILE__, __LINE__);
+      throw(e);
+    }
+    for (unsigned int i=0; i<objectGroups_template[k]->numObjects(); i++) {
+      objectGroups[k]->addObject(objectGroups_template[k]->get_objectAddress(i)->get_idObject());
+    }
+    for (unsigned int i=0; i<objectGroups[k]->numObjects(); i++) {
+      objects.push_back(objectGroups[k]->get_objectAddress(i));
+    }
+  }
+}
+
@@ -25,5 +25,14 @@ void instantiateObjects(
   vector<abstractObject*> &objects
 );
 
+// Instantiate the same objects as in 'objectGroups_template' (used for the
+// members of an ensemble, so that the declaration table is read only once).
+// The object groups must have been created in the same order.
+void instantiateObjects(
+  const vector<abstractObjectGroup*> &objectGroups_template,
+  vector<abstractObjectGroup*> &objectGroups,
+  vector<abstractObject*> &objects
+);
+
 #endif
 
@@ -0,0 +1,60 @@
+
+#ifndef ECHSE_COREFUNCT_MODELVARIANTS_H
+#define ECHSE_COREFUNCT_MODELVARIANTS_H
+
+////////////////////////////////////////////////////////////////////////////////
+// Variants of the generated object classes with and without range checks
+//
+// The generated code (bundled in 'AUTOechse_includeFiles.h') is compiled twice,
+// once in each of the namespaces 'uncheckedModel' and 'checkedModel' (see the
+// files 'echse_coreFunct_modelVariants_unchecked.cpp' and '..._checked.cpp').
+// In these namespaces, the names 'abstractObject' and 'sizedObject' used as
+// base classes by the generated code refer to the instances of the class
+// templates 'objectAccess' and 'sizedObject' with the respective value of the
+// argument CHECKED. Thus, the data access methods of the unchecked variant
+// contain no range checks at all and the variant is selected only once, when
+// the object groups are instantiated.
+//
+// Note: All headers possibly included by the generated code must be included
+//       here (i.e. at global scope) first. Otherwise, they would be expanded
+//       inside the namespaces.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#include "except/except.h"
+#include "table/table.h"
+#include "functions/functions.h"
+#include "typeconv/typeconv.h"
+#include "arrays/arrays.h"
+
+#include "echse_coreClass_abstractObject.h"
+#include "echse_coreClass_abstractObjectGroup.h"
+#include "echse_coreClass_templateObjectGroup.h"
+#include "echse_coreClass_objectAccess.h"
+#include "echse_coreClass_sizedObject.h"
+#include "echse_coreClass_multiState.h"
+#include "echse_coreFunct_solveODE.h"
+#include "echse_globalConst.h"
+
+using namespace std;
+
+// Instantiate the object groups of the engine (calls the function of the same
+// name from the generated code). The objects of the groups use the data access
+// methods without (1st function) or with range checks (2nd function).
+void instantiateObjectGroups_unchecked(vector<abstractObjectGroup*> &objectGroups);
+void instantiateObjectGroups_checked(vector<abstractObjectGroup*> &objectGroups);
+
+#endif
+
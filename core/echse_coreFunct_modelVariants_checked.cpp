@@ -0,0 +1,15 @@
+
+#include "echse_coreFunct_modelVariants.h"
+
+// Generated code using data access methods with range checks
+namespace checkedModel {
+  typedef objectAccess<true> abstractObject;
+  template<unsigned int NPARAMSNUM, unsigned int NINPUTSSIM, unsigned int NOUTPUTS>
+  using sizedObject= ::sizedObject<true, NPARAMSNUM, NINPUTSSIM, NOUTPUTS>;
+  #include "AUTOechse_includeFiles.h"
+}
+
+void instantiateObjectGroups_checked(vector<abstractObjectGroup*> &objectGroups) {
+  checkedModel::instantiateObjectGroups(objectGroups);
+}
+
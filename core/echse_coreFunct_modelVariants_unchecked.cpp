@@ -0,0 +1,15 @@
+
+#include "echse_coreFunct_modelVariants.h"
+
+// Generated code using data access methods without range checks
+namespace uncheckedModel {
+  typedef objectAccess<false> abstractObject;
+  template<unsigned int NPARAMSNUM, unsigned int NINPUTSSIM, unsigned int NOUTPUTS>
+  using sizedObject= ::sizedObject<false, NPARAMSNUM, NINPUTSSIM, NOUTPUTS>;
+  #include "AUTOechse_includeFiles.h"
+}
+
+void instantiateObjectGroups_unchecked(vector<abstractObjectGroup*> &objectGroups) {
+  uncheckedModel::instantiateObjectGroups(objectGroups);
+}
+
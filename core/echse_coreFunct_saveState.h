@@ -12,16 +12,21 @@
 #include "fixedZoneTime/fixedZoneTime.h"
 
 #include "echse_coreClass_abstractObject.h"
+#include "echse_coreFunct_checkpoint.h"
 #include "echse_globalConst.h"
 
 using namespace std;
 
+// Prints the values of scalar and vector states as text tables. The values
+// are taken from a snapshot of the objects created by 'checkpoint_snapshot'.
+// The objects are only used to get IDs, names, and lengths of vector states,
+// hence the method can run while the objects are simulated.
 void saveState(
   const string &outdir,
   const fixedZoneTime &now,
-  const vector<fixedZoneTime> &times_stateOutput,
   const string chars_colsep, const string chars_comment,
-  const vector<abstractObject*> &objects
+  const vector<abstractObject*> &objects,
+  const vector<char> &snapshot
 );
 
 #endif
@@ -0,0 +1,87 @@
+
+#include "echse_coreFunct_simulateStep.h"
+
+void simulateStep(
+  const vector<abstractObject*> &objects,
+  const vector< vector<unsigned int> > &processingTree,
+  const unsigned int singlethread_if_less_than,
+  const bool insideParallel,
+  const bool trap_fpe,
+  const unsigned int delta_t,
+  const int stepCounter, const int numberOfSteps,
+  const bool firstStep,
+  const string &stepStart_asString, const string &stepEnd_asString,
+  const bool printOutput,
+  const string &outdir, const string &outfmt, const string &chars_colsep
+) {
+  // Outer loop (loop over levels -- sequential processing)
+  for (unsigned int ix_outer=0; ix_outer < processingTree.size(); ix_outer++) {
+
+    // Exceptions are recorded by each thread separately and merged after
+    // the parallel region. Failures are counted by reduction (no locking).
+    unsigned int nExcept= 0;
+    const bool parallel= (!insideParallel) &&
+      (processingTree[ix_outer].size() >= singlethread_if_less_than);
+    #pragma omp parallel if(parallel) reduction(+:nExcept)
+    {
+    #pragma omp for
+    // Inner loop (loop over objects of one level -- may be processed in parallel)
+    for (unsigned int ix_inner=0; ix_inner < processingTree[ix_outer].size(); ix_inner++) {
+      // Index of current object
+      unsigned int i=processingTree[ix_outer][ix_inner];
+      // Run current object
+      try {
+        objects[i]->simulate(delta_t);        
+      } catch (except) {
+        stringstream errmsg;
+        errmsg << "Simulation failed for object '" << objects[i]->get_idObject() <<
+          "' in time step " << stepCounter << " of " << numberOfSteps <<
+          " starting at " << stepStart_asString << ".";
+        except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+        nExcept++;
+      }         
+      // Check for floating point exceptions
+      if (trap_fpe) {
+        try {
+          objects[i]->checkFPE();        
+        } catch (except) {
+          stringstream errmsg;
+          errmsg << "Floating point exception occurred in object '" << objects[i]->get_idObject() <<
+            "' in time step " << stepCounter << " of " << numberOfSteps <<
+            " starting at " << stepStart_asString << ".";
+          except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+          nExcept++;
+        }
+      }
+      // Output results
+      if (printOutput) {
+        try {
+          objects[i]->output_selected(firstStep,
+            outdir, outfmt,
+            chars_colsep, stepEnd_asString, delta_t);
+          objects[i]->output_debug(firstStep, outdir,
+            chars_colsep, stepEnd_asString);
+        } catch (except) {
+          stringstream errmsg;
+          errmsg << "Cannot print output for object '" << objects[i]->get_idObject() <<
+            "' at end of time step " << stepCounter << " of " << numberOfSteps <<
+            " starting at " << stepStart_asString << ".";
+          except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+          nExcept++;
+        }
+      }
+    } // End of loop over objects (inner)
+    // Hand over the exceptions recorded by this thread
+    if (!insideParallel) except::publish();
+    } // End of parallel region
+    if (!insideParallel) except::collect();
+    if (nExcept > 0) {
+      stringstream errmsg;
+      errmsg << nExcept << " exceptions registered in time step " << stepCounter <<
+        " of " << numberOfSteps << ".";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      throw(e);
+    }
+  } // End of loop over objects (outer)
+}
+
@@ -0,0 +1,47 @@
+#ifndef ECHSE_COREFUNCT_SIMULATESTEP_H
+#define ECHSE_COREFUNCT_SIMULATESTEP_H
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "except/except.h"
+
+#include "echse_coreClass_abstractObject.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Simulates a single time step for a set of objects
+////////////////////////////////////////////////////////////////////////////////
+
+// The objects are processed level by level as given by the processing tree
+// (outer vector: levels, inner vectors: indices of the objects of a level).
+// The objects of one level are processed in parallel if their number is at
+// least 'singlethread_if_less_than'. If 'printOutput' is true, outputs are
+// printed to 'outdir'.
+// If 'insideParallel' is true (call from within a parallel region, e.g. for
+// the members of an ensemble), the objects are processed by the calling thread
+// only and the exceptions remain in the records of that thread, i.e. they are
+// neither published nor collected. The caller is responsible for handing them
+// over after its own parallel region.
+// If the simulation, the check for floating point exceptions (optional), or
+// the output fails for any object, an exception is thrown after all objects
+// of the respective level have been processed.
+
+void simulateStep(
+  const vector<abstractObject*> &objects,
+  const vector< vector<unsigned int> > &processingTree,
+  const unsigned int singlethread_if_less_than,
+  const bool insideParallel,
+  const bool trap_fpe,
+  const unsigned int delta_t,
+  const int stepCounter, const int numberOfSteps,
+  const bool firstStep,
+  const string &stepStart_asString, const string &stepEnd_asString,
+  const bool printOutput,
+  const string &outdir, const string &outfmt, const string &chars_colsep
+);
+
+#endif
+
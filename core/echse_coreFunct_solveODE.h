@@ -3,10 +3,13 @@
 #define ECHSE_COREFUNCT_SOLVEODE_H
 
 #include <vector>
+#include <typeinfo>
+#include <type_traits>
 
 #include "echse_coreClass_abstractObject.h"
 
 #include "except/except.h"
+#include "odesolve/rkck.h"
 
 // gsl (GNU scientific library) with ode solvers and error handling
 #include <gsl/gsl_odeiv2.h>
@@ -27,5 +30,92 @@ void odesolve_nonstiff(
 	const int choice
 );
 
+////////////////////////////////////////////////////////////////////////////////
+// Adapter making an object's "derivsScal" method callable as 'f(t, u, dudt)'
+// by the solver core in 'odesolve/rkck.h'. For a concrete (most derived)
+// object class T, the call is qualified and thus resolved at compile time
+// instead of going through the virtual function table. The specialization for
+// the abstract base class uses the ordinary virtual call.
+////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+struct derivsScal_adapter {
+  T* objPtr;
+  unsigned int delta_t;
+  void operator()(const double t, const vector<double> &u, vector<double> &dudt) {
+    objPtr->T::derivsScal(t, u, dudt, delta_t);
+  }
+};
+
+template<>
+struct derivsScal_adapter<abstractObject> {
+  abstractObject* objPtr;
+  unsigned int delta_t;
+  void operator()(const double t, const vector<double> &u, vector<double> &dudt) {
+    objPtr->derivsScal(t, u, dudt, delta_t);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fifth order Cash-Karp Runge-Kutta with adaptive step size control over one
+// time step of length delta_t. The number of sub-steps is limited by nmax
+// through the minimum step size. The states are integrated in a local copy,
+// hence ystart and ynew may refer to the same vector.
+////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+void RKCK(
+  const vector<double> &ystart,
+  const unsigned int delta_t,
+  const double eps,
+  const unsigned int nmax,
+  T* objPtr,
+  vector<double> &ynew
+) {
+  derivsScal_adapter<T> f= {objPtr, delta_t};
+  vector<double> y(ystart);
+  rkck_solve(
+    y,
+    0.,                                        // x1
+    static_cast<double>(delta_t),              // x2
+    eps,
+    static_cast<double>(delta_t),              // h1
+    delta_t/max(1.,static_cast<double>(nmax)), // hmin
+    f
+  );
+  ynew= y;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Variant of 'odesolve_nonstiff' for pointers to concrete object classes, to be
+// called explicitly as 'odesolve_nonstiff_static(..., this, ...)' from a
+// model's "simulate" method. With the Cash-Karp method (choice 4), the
+// derivatives are computed without virtual calls. All other methods are
+// delegated to 'odesolve_nonstiff'.
+// Note: The non-virtual call is only used if T is the dynamic type of the
+//       object. For objects of a class derived from T (which may override
+//       "derivsScal"), the ordinary virtual call is used instead.
+////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+void odesolve_nonstiff_static(
+  const vector<double> &ystart,
+  const unsigned int delta_t,
+  const double eps,
+  const unsigned int nmax,
+  T* objPtr,
+  vector<double> &ynew,
+	const int choice
+) {
+  static_assert(is_base_of<abstractObject, T>::value,
+    "Template argument must be an object class derived from 'abstractObject'.");
+  if ((choice == 4) && (typeid(*objPtr) == typeid(T))) {
+    RKCK(ystart, delta_t, eps, nmax, objPtr, ynew);
+  } else {
+    odesolve_nonstiff(ystart, delta_t, eps, nmax, static_cast<abstractObject*>(objPtr),
+      ynew, choice);
+  }
+}
+
 #endif
 
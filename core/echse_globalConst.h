@@ -34,6 +34,9 @@ namespace globalConst {
     string locationID;         // Column with location IDs
     string index;              // Column with integer indices
     string digits;             // Column specifying a number of digits for output formatting
+    string interpolation;      // Column with a function's interpolation method (optional)
+    string member;             // Column with IDs of ensemble members
+    string key;                // Column with keys of the control file
   } const colNames= {
   // The names are defined below
     "object",
@@ -56,7 +59,10 @@ namespace globalConst {
     "weight",
     "location",
     "index",
-    "digits"
+    "digits",
+    "interpolation",
+    "member",
+    "key"
   };
 
   // File extenstions used for output files
@@ -64,11 +70,13 @@ namespace globalConst {
     string tabular;
     string debug;
     string json;
+    string checkpoint;
   } const fileExtensions= {
   // The names are defined below
     ".txt",
     ".dbg",
-    ".json"
+    ".json",
+    ".bin"
   };
 
   // Thresholds where the program's state should be printed (% done)
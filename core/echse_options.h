@@ -6,12 +6,18 @@
 // DEFINITION OF PREPROCESSOR MACROS FOLLOWS 
 ////////////////////////////////////////////////////////////////////////////////
 
-// Should vector indices in data access functions be explicitly checked for
-// out-of-range conditions?
-// If CHECK_RANGE != 0, checks are enabled. Use this for untested models!
-// Checks are turned off for maximum speed if CHECK_RANGE == 0. 
+// Note: The macro CHECK_RANGE is no longer used. Range checks in the data
+// access functions are selected at startup by the key 'check_range' of the
+// control file (see 'echse_coreFunct_modelVariants.h').
 
-#define CHECK_RANGE 0
+// Hint to the compiler that a function is rarely called. This is used for the
+// error handlers of the data access methods, which should not be inlined.
+
+#if defined(__GNUC__)
+#  define ECHSE_COLD __attribute__((cold, noinline))
+#else
+#  define ECHSE_COLD
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // END OF DEFINITION OF PREPROCESSOR MACROS
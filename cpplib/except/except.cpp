@@ -5,7 +5,9 @@
 // Definition of static members variables
 //==============================================================================
 
-vector<except::single_exception> except::exceptions;
+thread_local vector<except::single_exception> except::exceptions;
+vector<except::single_exception> except::published;
+mutex except::published_mutex;
 
 //==============================================================================
 // Constructors
@@ -107,3 +109,23 @@ void except::clear () {
   exceptions.clear();
 }
 
+// Number of exceptions recorded by the calling thread
+int except::count_thread () {
+  return(exceptions.size());
+}
+// Move the records of the calling thread to the shared buffer
+void except::publish () {
+  if (exceptions.size() > 0) {
+    lock_guard<mutex> lock(published_mutex);
+    published.insert(published.end(), exceptions.begin(), exceptions.end());
+    exceptions.clear();
+  }
+}
+// Append the contents of the shared buffer to the records of the calling thread
+void except::collect () {
+  lock_guard<mutex> lock(published_mutex);
+  if (published.size() > 0) {
+    exceptions.insert(exceptions.end(), published.begin(), published.end());
+    published.clear();
+  }
+}
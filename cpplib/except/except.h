@@ -9,6 +9,7 @@
 #include <iomanip>
 #include <fstream>
 #include <ctime>
+#include <mutex>
 
 using namespace std;
 
@@ -45,8 +46,13 @@ class except {
 				string get_file() const { return(sourcefile); }
 				int get_line() const { return(sourceline); }
 		};
-    // Data (static, to collect info on all exceptions in all program units)
-		static vector<single_exception> exceptions;
+    // Data (static, to collect info on all exceptions in all program units).
+    // Each thread records into a buffer of its own, hence exceptions can be
+    // created concurrently without locking (e.g. in parallel regions). Records
+    // are passed between threads through a shared buffer (see publish/collect).
+		static thread_local vector<single_exception> exceptions;
+		static vector<single_exception> published;
+		static mutex published_mutex;
   public:
     // Constructors (message may be a string or a stringstream)
     except (const string func, const string mess, const string file, const int line);
@@ -56,6 +62,11 @@ class except {
     void print() const;                  // Sends info on all recorded exceptions to stderr
     void print(const string file, const string fmt) const; // Sends info to file (fmt=xml|html|"")
     void clear();                        // Removes info on all recorded exceptions
+    // Transfer of records between threads. All methods below refer to the
+    // records of the calling thread.
+    static int count_thread();           // Returns the number of exceptions recorded by this thread
+    static void publish();               // Moves the records to the shared buffer (end of parallel region)
+    static void collect();               // Appends the shared buffer to the records (after parallel region)
 };
 
 #endif
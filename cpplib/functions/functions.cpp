@@ -1,106 +1,308 @@
-
 #include "functions.h"
 
 /*******************************************************************************
  Static members
 *******************************************************************************/
 const double tblFunction::FRACTOL_XSPACING= 1.0e-06;
+map<string, shared_ptr<tblFunction::T_cacheEntry> > tblFunction::cache;
+mutex tblFunction::cache_mutex;
 
 /*******************************************************************************
  Constructors / destructors
 *******************************************************************************/
 tblFunction::tblFunction() {
   name= "";
-  narg= 0;
-  index_lastaccess= 0;
 }
 tblFunction::~tblFunction() {
   name= "";
-  narg= 0;
-  index_lastaccess= 0;
-  x.resize(0);
-  fx.resize(0);
+  data.reset();
 }
 
 /*******************************************************************************
- Method to initialize a function table using two arrays
+ Private method to create the data of a function table using two arrays
 *******************************************************************************/
-void tblFunction::init(const string funcname, const vector<double> &args,
-  const vector<double> &vals
+shared_ptr<const tblFunction::T_data> tblFunction::make_data(const string &funcname,
+  const vector<double> &args, const vector<double> &vals,
+  const T_interpolation method
 ) {
   const double ZERO= 0.0;
   double xspacing, xspacing_first;
-  name= funcname;
-  narg= args.size();
+  shared_ptr<T_data> d(new T_data());
+  d->narg= args.size();
   // Check input dimensions
-  if (narg < 2) {
+  if (d->narg < 2) {
     stringstream errmsg;
-    errmsg << "Array of arguments for function '" << name << "' has length " <<
-      narg << ". Need at least two pairs of (argument, value).";
+    errmsg << "Array of arguments for function '" << funcname << "' has length " <<
+      d->narg << ". Need at least two pairs of (argument, value).";
     except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
   }
-  if (narg != vals.size()) {
+  if (d->narg != vals.size()) {
     stringstream errmsg;
     errmsg << "Array of arguments and array of values for function '" <<
-      name << "' differ in length.";
+      funcname << "' differ in length.";
     except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
   }
   // Copy
-  x.resize(narg);
-  fx.resize(narg);
-  x= args;
-  fx= vals;
-  // Initialize access index
-  index_lastaccess= floor(narg/2.);
+  d->x= args;
+  d->fx= vals;
   // Check arguments for ascending order and find out whether x is equispaced  
-  x_equispaced= true;
-  xspacing_first= x[1] - x[0];
-  for (size_type i=1; i<narg; i++) {
-    xspacing= x[i] - x[i-1];
+  d->x_equispaced= true;
+  xspacing_first= d->x[1] - d->x[0];
+  for (size_type i=1; i<d->narg; i++) {
+    xspacing= d->x[i] - d->x[i-1];
     if (xspacing <= ZERO) {
       stringstream errmsg;
-      errmsg << "Arguments for function '" << name << "' not in ascending" <<
-        " order. Value at" << " position " << i << " (" << x[i] <<
+      errmsg << "Arguments for function '" << funcname << "' not in ascending" <<
+        " order. Value at" << " position " << i << " (" << d->x[i] <<
         ") must be greater than value" << " at position " << (i-1) << " (" <<
-        x[i-1] << ").";  
+        d->x[i-1] << ").";  
 		  except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
 		  throw(e);      
     }
     if (abs(xspacing-xspacing_first) > (FRACTOL_XSPACING * 
       max(xspacing,xspacing_first))) {
-      x_equispaced= false;
+      d->x_equispaced= false;
     }
-  }  
+  }
+  // Precompute slopes (i.e. the coefficients for linear interpolation)
+  d->slope.resize(d->narg);
+  for (size_type i=0; i<(d->narg-1); i++) {
+    d->slope[i]= (d->fx[i+1] - d->fx[i]) / (d->x[i+1] - d->x[i]);
+  }
+  d->slope[d->narg-1]= ZERO;
+  // Precompute the coefficients for cubic interpolation
+  d->method= method;
+  switch (method) {
+    case linear:
+      break;
+    case monotoneCubic:
+      make_coefficients_monotoneCubic(*d);
+      break;
+    case naturalSpline:
+      make_coefficients_naturalSpline(*d);
+      break;
+  }
+  // Build the bucket index (not needed for equispaced arguments). The number
+  // of buckets equals the number of segments, so a bucket holds one segment on
+  // average.
+  if (!d->x_equispaced) {
+    const size_type nbuckets= d->narg - 1;
+    const double width= (d->x[d->narg-1] - d->x[0]) / nbuckets;
+    d->bucket_invwidth= nbuckets / (d->x[d->narg-1] - d->x[0]);
+    d->bucket_segment.resize(nbuckets);
+    size_type i= 0;
+    for (size_type b=0; b<nbuckets; b++) {
+      const double lower= d->x[0] + b * width;
+      while ((i < (d->narg-1)) && (d->x[i+1] <= lower)) i++;
+      d->bucket_segment[b]= i;
+    }
+  } else {
+    d->bucket_invwidth= ZERO;
+  }
+  return(d);
 }
 
 /*******************************************************************************
- Methods to initialize a function table from a tabular data file
+ Private methods to compute the coefficients for cubic interpolation
 *******************************************************************************/
-void tblFunction::read(const string file, const bool header,
-  const string chars_colsep, const string chars_comment, const string funcname,
-  const string colname_x, const string colname_fx
+
+// The methods are called by 'make_data' after the slopes of the segments have
+// been computed. They set the first derivatives at the tabulated points (stored
+// in 'slope') and the coefficients 'c2' and 'c3' of the cubic polynomials.
+
+// Set coefficients of the cubic Hermite polynomials from the derivatives at the
+// tabulated points (the slopes of the segments are replaced by 'deriv')
+namespace {
+  void set_hermite(vector<double> &slope, vector<double> &c2, vector<double> &c3,
+    const vector<double> &x, const vector<double> &deriv)
+  {
+    const size_t n= x.size();
+    c2.assign(n, 0.);
+    c3.assign(n, 0.);
+    for (size_t i=0; i<(n-1); i++) {
+      const double h= x[i+1] - x[i];
+      c2[i]= (3. * slope[i] - 2. * deriv[i] - deriv[i+1]) / h;
+      c3[i]= (deriv[i] + deriv[i+1] - 2. * slope[i]) / (h * h);
+    }
+    for (size_t i=0; i<(n-1); i++) {
+      slope[i]= deriv[i];
+    }
+  }
+}
+
+// Monotone piecewise cubic Hermite interpolation (Fritsch and Carlson, 1980)
+// with the derivatives computed as in Fritsch and Butland (1984). The
+// derivatives at the end points are computed by a shape-preserving three-point
+// formula.
+void tblFunction::make_coefficients_monotoneCubic(T_data &d) {
+  const size_type n= d.narg;
+  const vector<double> &x= d.x;
+  const vector<double> &s= d.slope;
+  vector<double> deriv(n);
+  if (n == 2) {
+    deriv[0]= s[0];
+    deriv[1]= s[0];
+  } else {
+    // Inner points: Weighted harmonic mean of the adjacent slopes or zero at
+    // local extrema
+    for (size_type i=1; i<(n-1); i++) {
+      if ((s[i-1] * s[i]) <= 0.) {
+        deriv[i]= 0.;
+      } else {
+        const double h0= x[i] - x[i-1];
+        const double h1= x[i+1] - x[i];
+        const double w1= 2. * h1 + h0;
+        const double w2= h1 + 2. * h0;
+        deriv[i]= (w1 + w2) / (w1 / s[i-1] + w2 / s[i]);
+      }
+    }
+    // End points
+    for (unsigned int k=0; k<2; k++) {
+      // Index of end point, the adjacent segment, and the next segment
+      const size_type i=  (k == 0) ? 0 : n-1;
+      const size_type j0= (k == 0) ? 0 : n-2;
+      const size_type j1= (k == 0) ? 1 : n-3;
+      const double h0= x[j0+1] - x[j0];
+      const double h1= x[j1+1] - x[j1];
+      double m= ((2. * h0 + h1) * s[j0] - h0 * s[j1]) / (h0 + h1);
+      if ((m * s[j0]) <= 0.) {
+        m= 0.;
+      } else if (((s[j0] * s[j1]) < 0.) && (abs(m) > abs(3. * s[j0]))) {
+        m= 3. * s[j0];
+      }
+      deriv[i]= m;
+    }
+  }
+  set_hermite(d.slope, d.c2, d.c3, x, deriv);
+}
+
+// Natural cubic spline (second derivative is zero at the end points). The
+// second derivatives at the tabulated points are found by solving a
+// tridiagonal system of equations.
+void tblFunction::make_coefficients_naturalSpline(T_data &d) {
+  const size_type n= d.narg;
+  const vector<double> &x= d.x;
+  const vector<double> &s= d.slope;
+  // Second derivatives (solution of the system)
+  vector<double> m2(n, 0.);
+  if (n > 2) {
+    // Forward elimination; the diagonal and right hand side are modified
+    vector<double> diag(n), rhs(n);
+    for (size_type i=1; i<(n-1); i++) {
+      diag[i]= 2. * (x[i+1] - x[i-1]);
+      rhs[i]= 6. * (s[i] - s[i-1]);
+      if (i > 1) {
+        const double h= x[i] - x[i-1];
+        const double f= h / diag[i-1];
+        diag[i]-= f * h;
+        rhs[i]-= f * rhs[i-1];
+      }
+    }
+    // Back substitution
+    for (size_type i=n-2; i>=1; i--) {
+      m2[i]= (rhs[i] - (x[i+1] - x[i]) * m2[i+1]) / diag[i];
+    }
+  }
+  // Coefficients
+  d.c2.assign(n, 0.);
+  d.c3.assign(n, 0.);
+  for (size_type i=0; i<(n-1); i++) {
+    const double h= x[i+1] - x[i];
+    d.slope[i]= s[i] - h * (2. * m2[i] + m2[i+1]) / 6.;
+    d.c2[i]= m2[i] / 2.;
+    d.c3[i]= (m2[i+1] - m2[i]) / (6. * h);
+  }
+}
+
+/*******************************************************************************
+ Method to convert the name of an interpolation method
+*******************************************************************************/
+tblFunction::T_interpolation tblFunction::interpolation_method(const string &name) {
+  if (name == "linear") return(linear);
+  if (name == "monotoneCubic") return(monotoneCubic);
+  if (name == "naturalSpline") return(naturalSpline);
+  stringstream errmsg;
+  errmsg << "Unknown interpolation method '" << name << "'. Expecting 'linear'," <<
+    " 'monotoneCubic', or 'naturalSpline'.";
+  except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+  throw(e);
+}
+
+/*******************************************************************************
+ Private method to create the data of a function table from a data file
+*******************************************************************************/
+shared_ptr<const tblFunction::T_data> tblFunction::read_data(const string &file,
+  const bool header, const string &chars_colsep, const string &chars_comment,
+  const string &funcname, const string &colname_x, const string &colname_fx,
+  const T_interpolation method
 ) {
 	table tab;
 	vector<string> x_str, fx_str;
   vector<double> x_num, fx_num;
+	tab.read(file, header, chars_colsep, chars_comment);
+	tab.get_col(tab.colindex(colname_x), x_str);
+	tab.get_col(tab.colindex(colname_fx), fx_str);
+  tab.clear();
+  convert_type(x_str, x_num);
+  convert_type(fx_str, fx_num);
+/* This alternative code for the two statements above has very similar performance
+  x_num.resize(x_str.size());
+  fx_num.resize(fx_str.size());
+  for (unsigned int i=0; i<x_str.size(); i++) {
+    x_num[i]= as_double(x_str[i]); 
+    fx_num[i]= as_double(fx_str[i]); 
+  }
+*/
+	return(make_data(funcname, x_num, fx_num, method));
+}
+
+/*******************************************************************************
+ Method to initialize a function table using two arrays
+*******************************************************************************/
+void tblFunction::init(const string funcname, const vector<double> &args,
+  const vector<double> &vals, const T_interpolation method
+) {
+  name= funcname;
+  data= make_data(funcname, args, vals, method);
+}
+
+/*******************************************************************************
+ Methods to initialize a function table from a tabular data file
+*******************************************************************************/
+
+// The data are taken from the cache if the same columns of the same file were
+// read before. Otherwise, the file is read and the data are added to the cache.
+// Only the cache entry is locked while a file is read, hence different files
+// can be read by multiple threads at the same time.
+void tblFunction::read(const string file, const bool header,
+  const string chars_colsep, const string chars_comment, const string funcname,
+  const string colname_x, const string colname_fx,
+  const T_interpolation method
+) {
   name= funcname;
 	try {
-		tab.read(file, header, chars_colsep, chars_comment);
-		tab.get_col(tab.colindex(colname_x), x_str);
-		tab.get_col(tab.colindex(colname_fx), fx_str);
-    convert_type(x_str, x_num);
-    convert_type(fx_str, fx_num);
-/* This alternative code for the two statements above has very similar performance
-    x_num.resize(x_str.size());
-    fx_num.resize(fx_str.size());
-    for (unsigned int i=0; i<x_str.size(); i++) {
-      x_num[i]= as_double(x_str[i]); 
-      fx_num[i]= as_double(fx_str[i]); 
+    // Find or create the cache entry
+    stringstream key;
+    key << file << '\n' << colname_x << '\n' << colname_fx << '\n' <<
+      header << '\n' << chars_colsep << '\n' << chars_comment << '\n' << method;
+    shared_ptr<T_cacheEntry> entry;
+    {
+      lock_guard<mutex> lock(cache_mutex);
+      shared_ptr<T_cacheEntry> &e= cache[key.str()];
+      if (!e) e.reset(new T_cacheEntry());
+      entry= e;
+    }
+    // Read the data if not yet available
+    {
+      lock_guard<mutex> lock(entry->entry_mutex);
+      if (!entry->data) {
+        entry->data= read_data(file, header, chars_colsep, chars_comment,
+          funcname, colname_x, colname_fx, method);
+      }
+      data= entry->data;
     }
-*/
-		init(funcname, x_num, fx_num);
 	} catch (except) {
 		stringstream errmsg;
 		errmsg << "Could not initialize function '" << name <<
@@ -109,94 +311,167 @@ void tblFunction::read(const string file, const bool header,
 		except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
 	}
-	tab.clear();
-	x_str.resize(0);
-	fx_str.resize(0);
-	x_num.resize(0);
-	fx_num.resize(0);
+}
+
+/*******************************************************************************
+ Method to release the cache of function tables
+*******************************************************************************/
+void tblFunction::clear_cache() {
+  lock_guard<mutex> lock(cache_mutex);
+  cache.clear();
 }
 
 /*******************************************************************************
  Methods to return the argument range
 *******************************************************************************/
 double tblFunction::minarg() const {
-  if (x.size() == 0) {
+  if (!data) {
 		except e(__PRETTY_FUNCTION__, "Function not initialized.", __FILE__, __LINE__);
 		throw(e);
 	}
-  return(x[0]);
+  return(data->x[0]);
 }
 double tblFunction::maxarg() const {
-  if (x.size() == 0) {
+  if (!data) {
 		except e(__PRETTY_FUNCTION__, "Function not initialized.", __FILE__, __LINE__);
 		throw(e);
 	}
-  return(x[narg-1]);
+  return(data->x[data->narg-1]);
 }
 
 /*******************************************************************************
- Method to evaluate the tabulated function
+ Methods to evaluate the tabulated function
 *******************************************************************************/
-double tblFunction::eval(const double arg) {
-  const double UNITY= 1.0;
-  double weight;
-  size_type i;
-  if (x.size() == 0) {
+
+// Check of the argument (called before the lookup)
+void tblFunction::check_arg(const double arg) const {
+  if (!data) {
 		except e(__PRETTY_FUNCTION__, "Function not initialized.", __FILE__, __LINE__);
 		throw(e);
 	}
-  // Check range
-  if ((arg < x[0]) || (arg > x[narg-1])) {
+  if (isnan(arg)) {
+    stringstream errmsg;
+    errmsg << "Cannot return value of function '" << name << "'." <<
+      " The argument is not a valid floating point number.";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  if ((arg < data->x[0]) || (arg > data->x[data->narg-1])) {
     stringstream errmsg;
     errmsg << "Unable to evaluate function '" << name << "' for argument '" <<
-      arg << "'. Expecting argument in range [" << x[0] << ", " << x[narg-1] <<
-      "].";  
+      arg << "'. Expecting argument in range [" << data->x[0] << ", " <<
+      data->x[data->narg-1] << "].";  
 	  except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
 	  throw(e);      
   }
-  if (x_equispaced) {
-    // Find solution by index
-		i= floor( (static_cast<double>(narg)-UNITY) * (arg-x[0])/(x[narg-1]-x[0]) );
-		if (i == (narg-1)) {
-		  return( fx[narg-1] );
-		} else {
-      weight= (x[i+1]-arg) / (x[i+1]-x[i]);
-		  return( fx[i] * weight + fx[i+1] * (UNITY-weight) );
-		}
-  } else {
-    // Find solution by search and update access index
-		if (arg >= x[index_lastaccess]) {
-	    // Forward search
-			for (size_type i=index_lastaccess; i<(narg-1); i++) {
-				if ((x[i] <= arg) && (x[i+1] >= arg)) {
-          index_lastaccess= i;
-				  weight= (x[i+1]-arg) / (x[i+1]-x[i]);
-					return( fx[i] * weight + fx[i+1] * (UNITY-weight) );
-				}
-			}
-		} else {
-	    // Backward search (loops counts down to 1, not zero, to avoid problems
-      // with unsigned int counter)
-			for (size_type i=index_lastaccess; i>=1; i--) {
-				if ((x[i-1] <= arg) && (x[i] >= arg)) {
-          index_lastaccess= i-1;
-				  weight= (x[i]-arg) / (x[i]-x[i-1]);
-					return( fx[i-1] * weight + fx[i] * (UNITY-weight) );
-				}
-			}
-		}
-    // We may only arrive here if
-    // - the argument vector is unsorted (sorting is done by .init)
-    // - the argument for which the function is evaluated is not a valid number
-    if (!isnormal(arg)) {
-      stringstream errmsg;
-      errmsg << "Cannot return value of function '" << name << "'." <<
-        " The argument is not a valid floating point number.";
-      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-      throw(e);
+}
+
+// Interpolation in the segment [x[i], x[i+1]] using the precomputed coefficients
+inline double tblFunction::interpolate(const size_type i, const double arg) const {
+  const T_data &d= *data;
+  const double dx= arg - d.x[i];
+  if (d.method == linear) {
+    return( d.fx[i] + d.slope[i] * dx );
+  }
+  return( d.fx[i] + dx * (d.slope[i] + dx * (d.c2[i] + dx * d.c3[i])) );
+}
+
+// Search for the segment with x[i] <= arg < x[i+1] (or i == narg-1 if arg is
+// the last argument) using the bucket index. The argument must be valid. The
+// search is limited to the segments between those containing the lower and
+// the upper bound of the argument's bucket, which are searched by bisection.
+// Thus, a lookup takes a few steps for evenly spread arguments and O(log n)
+// steps if many arguments are clustered in a single bucket. The range is
+// widened if the bucket is wrong due to rounding errors.
+inline tblFunction::size_type tblFunction::find_segment(const double arg) const {
+  const vector<double> &x= data->x;
+  const vector<size_type> &bs= data->bucket_segment;
+  const size_type last= data->narg - 1;
+  const size_type nbuckets= bs.size();
+  size_type b= static_cast<size_type>((arg - x[0]) * data->bucket_invwidth);
+  if (b >= nbuckets) b= nbuckets - 1;
+  size_type lo= bs[b];
+  size_type hi= ((b+1) < nbuckets) ? min(bs[b+1] + 1, last) : last;
+  if (x[lo] > arg) lo= 0;
+  if (x[hi] <= arg) hi= last;
+  // First argument greater than 'arg' among x[lo+1] ... x[hi]
+  return( (upper_bound(x.begin() + lo + 1, x.begin() + hi + 1, arg) - x.begin()) - 1 );
+}
+
+// Lookup for equispaced arguments (segment found by index)
+inline double tblFunction::eval_equispaced(const double arg) const {
+  const double UNITY= 1.0;
+  const vector<double> &x= data->x;
+  const size_type narg= data->narg;
+  size_type i= floor( (static_cast<double>(narg)-UNITY) * (arg-x[0])/(x[narg-1]-x[0]) );
+  // Correct for rounding errors (arguments are only approximately equispaced)
+  if ((i < (narg-1)) && (x[i+1] <= arg)) {
+    i++;
+  } else if (x[i] > arg) {
+    i--;
+  }
+  return( interpolate(i, arg) );
+}
+
+// Stateless lookup: the segment is found using the bucket index. This method
+// can be used by multiple threads concurrently.
+double tblFunction::eval(const double arg) const {
+  check_arg(arg);
+  if (data->x_equispaced) {
+    return( eval_equispaced(arg) );
+  }
+  return( interpolate(find_segment(arg), arg) );
+}
+
+// Search for the segment using a hint, i.e. the segment found for a previous
+// argument. The hinted segment and the next one are tested first, which is
+// fast if the argument changes little between successive lookups. Otherwise,
+// the bucket index is used. Any value is accepted as the hint.
+inline tblFunction::size_type tblFunction::find_segment_near(const double arg,
+  const size_type hint
+) const {
+  const vector<double> &x= data->x;
+  const size_type last= data->narg - 1;
+  size_type i= min(hint, last);
+  if ((arg < x[i]) || ((i < last) && (arg >= x[i+1]))) {
+    if ((i < last) && (arg >= x[i+1]) && (((i+1) == last) || (arg < x[i+2]))) {
+      i++;
+    } else {
+      i= find_segment(arg);
     }
-    except e(__PRETTY_FUNCTION__,"Bug in source code.",__FILE__,__LINE__);
-    throw(e);
   }
+  return(i);
+}
+
+// Lookup using a cursor owned by the caller. The cursor holds the segment
+// found in the previous call and is updated.
+double tblFunction::eval(const double arg, size_type &cursor) const {
+  check_arg(arg);
+  if (data->x_equispaced) {
+    return( eval_equispaced(arg) );
+  }
+  cursor= find_segment_near(arg, cursor);
+  return( interpolate(cursor, arg) );
 }
 
+// Lookup for an array of arguments. All arguments are checked first, so the
+// loops doing the interpolation contain no branches for error handling.
+void tblFunction::eval_many(const double* args, double* out,
+  const size_type n
+) const {
+  if (n == 0) return;
+  for (size_type k=0; k<n; k++) {
+    check_arg(args[k]);
+  }
+  if (data->x_equispaced) {
+    for (size_type k=0; k<n; k++) {
+      out[k]= eval_equispaced(args[k]);
+    }
+  } else {
+    size_type i= 0;
+    for (size_type k=0; k<n; k++) {
+      i= find_segment_near(args[k], i);
+      out[k]= interpolate(i, args[k]);
+    }
+  }
+}
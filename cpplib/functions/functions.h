@@ -6,6 +6,11 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
 #include "../except/except.h"
 #include "../table/table.h"
 #include "../typeconv/typeconv.h"
@@ -13,35 +18,101 @@
 using namespace std;
 
 class tblFunction {
-  private:
-    // Types and constants
+  public:
+    // Types
     typedef unsigned int size_type;
+    // Interpolation methods. With the cubic methods, the function and its
+    // first derivative are continuous. The monotone method (Fritsch-Carlson)
+    // does not create extrema between the tabulated points. The natural
+    // spline has a continuous second derivative but may overshoot.
+    enum T_interpolation { linear, monotoneCubic, naturalSpline };
+  private:
+    // Constants
     static const double FRACTOL_XSPACING;
+    // Data of a function table. The data are not modified after initialization
+    // and can be shared by several instances (see 'read').
+    struct T_data {
+      vector<double> x;
+      vector<double> fx;
+      size_type narg;
+      bool x_equispaced;
+      T_interpolation method;
+      // Precomputed coefficients of the polynomials for the segments
+      // [x[i], x[i+1]]. With d= arg - x[i], the value is
+      //   fx[i] + d * (slope[i] + d * (c2[i] + d * c3[i]))
+      // where 'slope' is the first derivative at x[i]. The vectors 'c2' and
+      // 'c3' are empty for linear interpolation. The last elements (for the
+      // argument x[narg-1]) are zero.
+      vector<double> slope;
+      vector<double> c2;
+      vector<double> c3;
+      // Acceleration index for non-equispaced arguments: The argument range
+      // is divided into buckets of equal width. For each bucket, the index of
+      // the segment containing the bucket's lower bound is stored.
+      vector<size_type> bucket_segment;
+      double bucket_invwidth;
+    };
+    // Process-wide cache of function tables read from files. The key is made
+    // up of the file name, the names of the argument and value columns, and
+    // the reading options.
+    struct T_cacheEntry {
+      mutex entry_mutex;             // Locked while the file is read
+      shared_ptr<const T_data> data; // Empty until read successfully
+    };
+    static map<string, shared_ptr<T_cacheEntry> > cache;
+    static mutex cache_mutex;
     // Function name
     string name;
-    // The function
-    vector<double> x;
-    vector<double> fx;
-    // Data to facilitate data access
-    size_type narg;
-    size_type index_lastaccess;
-    bool x_equispaced;
+    // The function (possibly shared)
+    shared_ptr<const T_data> data;
+    // Private methods
+    void check_arg(const double arg) const;
+    double interpolate(const size_type i, const double arg) const;
+    size_type find_segment(const double arg) const;
+    size_type find_segment_near(const double arg, const size_type hint) const;
+    double eval_equispaced(const double arg) const;
+    static shared_ptr<const T_data> make_data(const string &funcname,
+      const vector<double> &args, const vector<double> &vals,
+      const T_interpolation method);
+    static void make_coefficients_monotoneCubic(T_data &d);
+    static void make_coefficients_naturalSpline(T_data &d);
+    static shared_ptr<const T_data> read_data(const string &file, const bool header,
+      const string &chars_colsep, const string &chars_comment, const string &funcname,
+      const string &colname_x, const string &colname_fx,
+      const T_interpolation method);
   public:
     // Constructors/destructors
     tblFunction();
     ~tblFunction();
+    // Method to convert the name of an interpolation method ('linear',
+    // 'monotoneCubic', or 'naturalSpline') into the code
+    static T_interpolation interpolation_method(const string &name);
     // Method to initialize a function table using two arrays
     void init(const string funcname, const vector<double> &args,
-      const vector<double> &vals);
-    // Method to initialize a function table from data file
+      const vector<double> &vals, const T_interpolation method= linear);
+    // Method to initialize a function table from data file. A file is read
+    // only once per process for a particular combination of columns; all
+    // functions initialized from the same data share a single copy.
 		void read(const string file, const bool header, const string chars_colsep,
       const string chars_comment, const string funcname,
-      const string colname_x, const string colname_fx);
+      const string colname_x, const string colname_fx,
+      const T_interpolation method= linear);
+    // Method to release the cache of function tables (functions initialized
+    // before remain valid)
+    static void clear_cache();
     // Methods to get argument range
     double minarg() const;
     double maxarg() const;
-    // Method to lookup a value
-    double eval(const double arg); // Not const because of access index update
+    // Methods to lookup a value. Both methods can be used by multiple threads
+    // concurrently. The second one is faster for successive lookups with
+    // similar arguments. It uses a cursor owned by the caller (one cursor per
+    // function and thread; any initial value is accepted).
+    double eval(const double arg) const;
+    double eval(const double arg, size_type &cursor) const;
+    // Method to lookup the values for an array of 'n' arguments. This is
+    // fastest if the arguments are sorted. An exception is thrown if any
+    // argument is invalid.
+    void eval_many(const double* args, double* out, const size_type n) const;
 };
 
 #endif
@@ -9,6 +9,7 @@
 
 #include "../except/except.h"
 #include "../functions/functions.h"
+#include "rkck.h"
 
 using namespace std;
 
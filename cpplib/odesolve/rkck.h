@@ -0,0 +1,379 @@
+#ifndef RKCK_H
+#define RKCK_H
+
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+
+#include "../except/except.h"
+
+using namespace std;
+
+// Header-only core of the Cash-Karp Runge-Kutta integrator with adaptive step
+// size control. Routines adapted from "Numerical Recipes in Fortran", vol 1 & 2
+// (F77 & F90).
+//
+// The routines are templates with respect to
+//  - the state container S: Any type providing size(), operator[] and a copy
+//    constructor, e.g. vector<double>, valarray<double> or array<double,N>.
+//    With array<double,N> the number of states is a compile-time constant and
+//    the loops over the states can be fully unrolled by the compiler.
+//  - the RHS functor F: Any type callable as 'derivs(x, y, dydx)' with
+//    signature 'void (const double x, const S &y, S &dydx)'. Since the functor
+//    type is known at compile time, the call is resolved statically and can be
+//    inlined.
+//
+// History
+// - Merged the former copies in 'odesolve.cpp' and the ECHSE core in 2026.
+// - Adapted for use within the ECHSE in 2012.
+// - Translated to C++ in 2010.
+// - Adapted Fortran version in 2006/07.
+
+////////////////////////////////////////////////////////////////////////////////
+/// \struct rkck_workspace
+///
+/// \brief Scratch arrays used by the Cash-Karp stepper. The arrays are
+/// allocated once per call of the driver (rkck_solve) instead of once per
+/// (trial) step. All arrays are copy-constructed from a template state to get
+/// the proper size for dynamically sized containers.
+////////////////////////////////////////////////////////////////////////////////
+
+template<class S>
+struct rkck_workspace {
+  S dydx, ak2, ak3, ak4, ak5, ak6, ytemp, yerr, ynext, yscal;
+  explicit rkck_workspace(const S &y) : dydx(y), ak2(y), ak3(y), ak4(y),
+    ak5(y), ak6(y), ytemp(y), yerr(y), ynext(y), yscal(y) { }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \fn void rkck_fixedStepSize(
+///   const S &y,
+///   const S &dydx,
+///   const double x,
+///   const double h,
+///   F &derivs,
+///   rkck_workspace<S> &w,
+///   S &yout,
+///   S &yerr
+/// )
+///
+/// \brief Given values for n variables y and their derivatives dydx known at x,
+/// use the fifth order Cash-Karp Runge-Kutta method to advance the solution over
+/// an interval h and return the incremented variables as yout. Also return an
+/// estimate of the local truncation error in yout using the embedded fourth order
+/// method. The user supplies the functor, which returns derivatives dydx at x.
+/// (Cited from Numerical Recipes in F77/F90).
+///
+/// \par [in] y
+///    States y at point x, i.e. y(x).
+/// \par [in] dydx
+///    The states' derivatives at x, i.e. dy(x)/dx.
+/// \par [in] x
+///    Value of x where y and dydx are known.
+/// \par [in] h
+///   Length of step along the x-axis.
+/// \par [in] derivs
+///   Functor which computes the derivatives of y with respect to x.
+/// \par [inout] w
+///   Workspace providing the stage arrays (must have the size of y).
+/// \par [out] yout
+///   Estimates of the states y at x+h, i.e. y(x+h).
+/// \par [out] yerr
+///   Estimated error in yout.
+///
+/// \return
+///   \c void
+///
+/// \remarks
+///   \li This function is not to be called directly but by another function.
+///   \li The arrays yout and yerr must not alias y or dydx.
+///   \li The function may thow an exception of class "except".
+////////////////////////////////////////////////////////////////////////////////
+
+template<class S, class F>
+void rkck_fixedStepSize(
+  const S &y,
+  const S &dydx,
+  const double x,
+  const double h,
+  F &derivs,
+  rkck_workspace<S> &w,
+  S &yout,
+  S &yerr
+) {
+  // Parameters of the Runge-Kutta method by Cash-Karp
+  const double A2=0.2, A3=0.3, A4=0.6 ,A5=1.0, A6=0.875, B21=0.2, B31=3.0/40.0,
+    B32=9.0/40.0, B41=0.3, B42=-0.9, B43=1.2, B51=-11.0/54.0, B52=2.5,
+    B53=-70.0/27.0, B54=35.0/27.0, B61=1631.0/55296.0, B62=175.0/512.0,
+    B63=575.0/13824.0, B64=44275.0/110592.0, B65=253.0/4096.0, C1=37.0/378.0,
+    C3=250.0/621.0, C4=125.0/594.0, C6=512.0/1771.0, DC1=C1-2825.0/27648.0,
+    DC3=C3-18575.0/48384.0, DC4=C4-13525.0/55296.0, DC5=-277.0/14336.0,
+    DC6=C6-0.25;
+  // Local data
+  const unsigned int ny= y.size();
+  S &ak2= w.ak2, &ak3= w.ak3, &ak4= w.ak4, &ak5= w.ak5, &ak6= w.ak6, &ytemp= w.ytemp;
+  // Code
+  try {
+    // First step
+    for (unsigned int i=0; i<ny; i++) ytemp[i]= y[i] + B21 * h * dydx[i];
+    // Second step
+    derivs(x+A2*h, ytemp, ak2);
+    for (unsigned int i=0; i<ny; i++) ytemp[i]= y[i] + h * (B31 * dydx[i] + B32 * ak2[i]);
+    // Third step
+    derivs(x+A3*h, ytemp, ak3);
+    for (unsigned int i=0; i<ny; i++) ytemp[i]= y[i] + h * (B41 * dydx[i] + B42 * ak2[i] + B43 * ak3[i]);
+    // Fourth step
+    derivs(x+A4*h, ytemp, ak4);
+    for (unsigned int i=0; i<ny; i++) ytemp[i]= y[i] + h * (B51 * dydx[i] + B52 * ak2[i] + B53 * ak3[i] + B54 * ak4[i]);
+    // Fifth step
+    derivs(x+A5*h, ytemp, ak5);
+    for (unsigned int i=0; i<ny; i++) ytemp[i]= y[i] + h * (B61 * dydx[i] + B62 * ak2[i] + B63 * ak3[i] + B64 * ak4[i] + B65 * ak5[i]);
+    // Sixth step
+    derivs(x+A6*h, ytemp, ak6);
+    // Accumulate increments with proper weights
+    for (unsigned int i=0; i<ny; i++) yout[i]= y[i] + h * (C1 * dydx[i] + C3 * ak3[i] + C4 * ak4[i] + C6 * ak6[i]);
+    // Estimate error as difference between fourth and fifth order methods
+    for (unsigned int i=0; i<ny; i++) yerr[i]= h * (DC1 * dydx[i] + DC3 * ak3[i] + DC4 * ak4[i] + DC5 * ak5[i] + DC6 * ak6[i]);
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__,"Could not estimate states and errors.",__FILE__,__LINE__);
+    throw(e);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \fn void rkck_errDependStepSize(
+///   S &y,
+///   const S &dydx,
+///   double &x,
+///   const double htry,
+///   const double eps,
+///   const S &yscal,
+///   F &derivs,
+///   rkck_workspace<S> &w,
+///   double &hdid,
+///   double &hnext
+/// )
+///
+/// \brief Fifth order Runge-Kutta step with monitoring of local truncation
+/// error to ensure accuracy and adjust stepsize (actual stepsize is determined
+/// automatically).
+/// (Cited from Numerical Recipes in F77/F90).
+///
+/// \par [inout] y
+///    States y at starting value of x, i.e. y(x). The values are replaced by
+///    the new results.
+/// \par [in] dydx
+///    The states' derivatives at starting value of x, i.e. dy(x)/dx.
+/// \par [inout] x
+///    Starting value of the independend variable. The value is replaced by the
+///    new value (x + hdid).
+/// \par [in] htry
+///   Step size to be attempted.
+/// \par [in] eps
+///   Required accuracy.
+/// \par [in] yscal
+///   Values against which the error is scaled.
+/// \par [in] derivs
+///   Functor which computes the derivatives of y with respect to x.
+/// \par [inout] w
+///   Workspace providing the stage arrays (must have the size of y).
+/// \par [out] hdid
+///   Stepsize that was actually accomplished.
+/// \par [out] hnext
+///   Estimated step size for the next step.
+///
+/// \return
+///   \c void
+///
+/// \remarks
+///   \li This function is not to be called directly but by another function.
+///   \li The arguments dydx and yscal must not be members of the workspace w
+///       other than w.dydx and w.yscal.
+///   \li The function may thow an exception of class "except".
+////////////////////////////////////////////////////////////////////////////////
+
+template<class S, class F>
+void rkck_errDependStepSize(
+  S &y,
+  const S &dydx,
+  double &x,
+  const double htry,
+  const double eps,
+  const S &yscal,
+  F &derivs,
+  rkck_workspace<S> &w,
+  double &hdid,
+  double &hnext
+) {
+  // Local data
+  const double SAFETY=0.9, PGROW=-0.2, PSHRNK=-0.25, ERRCON=1.89e-4;
+  const double ZERO= 0.0, ONE=1.0, TENTH=0.1, FIVE=5.0;
+  const unsigned int ny= y.size();
+  double errmax, h, htemp, xnew;
+  // Code
+  try {
+    // Set stepsize to the initial trial value
+    h= htry;
+    while(true) {
+      // Take a step using 5th-order runge-kutta-cash-karp
+      try {
+        rkck_fixedStepSize(y, dydx, x, h, derivs, w, w.ynext, w.yerr);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__,"Calculation for fixed step size failed.",__FILE__,__LINE__);
+        throw(e);
+      }
+      // Evaluate accuracy (replaces the vector statement 'errmax= (abs(yerr/yscal)).max() / eps')
+      errmax= ZERO;
+      for (unsigned int i=0; i<ny; i++) errmax= max(errmax, abs(w.yerr[i]/yscal[i]));
+      errmax= errmax / eps;
+      // Exit loop if step succeeded
+      if (errmax <= ONE) {
+        break;
+      }
+      // Truncation error too large, reduce stepsize
+      htemp= SAFETY * h * pow(errmax,PSHRNK);
+      // No more than a factor of 10
+      h= copysign(max(abs(htemp),TENTH*abs(h)),h);
+      xnew= x+h;
+      if (xnew == x) {
+        except e(__PRETTY_FUNCTION__,"Automatic step size dropped to zero.",__FILE__,__LINE__);
+        throw(e);
+      }
+      // Go back for another try
+    }
+    // Compute size for the next step
+    if (errmax > ERRCON) {
+      hnext= SAFETY * h * pow(errmax,PGROW);
+    } else {
+      // No more than a factor of 5 increase
+      hnext= FIVE * h;
+    }
+    hdid= h;
+    x= x + h;
+    for (unsigned int i=0; i<ny; i++) y[i]= w.ynext[i];
+  } catch (except) {
+    except e(__PRETTY_FUNCTION__,"Failed.",__FILE__,__LINE__);
+    throw(e);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \fn void rkck_solve(
+///   S &y,
+///   const double x1,
+///   const double x2,
+///   const double eps,
+///   const double h1,
+///   const double hmin,
+///   F &derivs
+/// )
+///
+/// \brief Runge-Kutta driver with adaptive stepsize control. Integrate the
+/// array of starting values y from x1 to x2 with accuracy eps.
+/// (Cited from Numerical Recipes in F77/F90).
+///
+/// \par [inout] y
+///    Dependent (state) variables y at starting value of x=x1. The values are
+///    replaced by the result values obtained at the end of the integration
+///    interval (x2).
+/// \par [in] x1
+///    Starting value of x.
+/// \par [in] x2
+///    Target value of x (upper limit of integration interval).
+/// \par [in] eps
+///   Required accuracy.
+/// \par [in] h1
+///   Guessed first step size.
+/// \par [in] hmin
+///   Minimum acceptable step size (can be zero).
+/// \par [in] derivs
+///   Functor which computes the derivatives of y with respect to x. It is not
+///   a const reference, since evaluation of the derivatives may change data
+///   (e.g. the index of the last accessed argument of lookup functions).
+///
+/// \return
+///   \c void
+///
+/// \remarks
+///   \li Changes in comparison with the original Fortran code: (1) Routines
+///       from module "nrutil" have been replaced by in-line code. (2) Fortran
+///       vector arithmetic expressions were replaced by loops. (3) Fortran
+///       sign() replaced by C's copysign(). (4) No storage of intermediate
+///       results (part of code deleted). (5) A functor is used instead of a
+///       function pointer. (6) Scratch arrays are allocated once per call.
+///   \li If an exception is thrown, the contents of y are undefined.
+///   \li The function may thow an exception of class "except".
+////////////////////////////////////////////////////////////////////////////////
+
+template<class S, class F>
+void rkck_solve(
+  S &y,
+  const double x1,
+  const double x2,
+  const double eps,
+  const double h1,
+  const double hmin,
+  F &derivs
+) {
+  // Local data
+  const double TINY=1.0e-30;
+  const double ZERO=0.0;
+  const unsigned int MAXSTP=10000;
+  const unsigned int ny= y.size();
+  double h, hdid, hnext, x;
+  rkck_workspace<S> w(y);
+  bool ok;
+  // Code
+  try {
+    // Initializations
+    x= x1;
+    h= copysign(h1, x2-x1);
+    // Take at most MAXSTP steps
+    ok= false;
+    for (unsigned int nstp=1; nstp<=MAXSTP; nstp++) {
+      // Compute derivatives at the start of the step
+      derivs(x, y, w.dydx);
+      // Scaling used to monitor accuracy. This general purpose choice can be modified.
+      for (unsigned int i=0; i<ny; i++) w.yscal[i]= abs(y[i]) + abs(h * w.dydx[i]) + TINY;
+      // If stepsize can overshoot, decrease
+      if (((x+h-x2)*(x+h-x1)) > ZERO) {
+        h= x2-x;
+      }
+      // Make a step with error dependend stepsize
+      try {
+        rkck_errDependStepSize(y, w.dydx, x, h, eps, w.yscal, derivs, w, hdid, hnext);
+      } catch (except) {
+        except e(__PRETTY_FUNCTION__,"Exception in subroutine.",__FILE__,__LINE__);
+        throw(e);
+      }
+      // Are we done?
+      if (((x-x2)*(x2-x1)) >= ZERO) {
+        ok= true;
+        break;
+      }
+      if (abs(hnext) < hmin) {
+        stringstream errmsg;
+        errmsg << "Stepsize in Runge-Kutta ODE solver reached lower limit" <<
+          " of " << hmin << ".";
+        except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+        throw(e);
+      }
+      h= hnext;
+    }
+    if (!ok) {
+      stringstream errmsg;
+      errmsg << "Runge-Kutta ODE solver could not find a solution of the" <<
+        " requested accuracy within " << MAXSTP << " integration steps.";
+      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+      throw(e);
+    }
+  } catch (except) {
+    stringstream errmsg;
+    errmsg << "Could not integrate ODE system of size " << ny <<
+      " over time step of length " << x2-x1 << ".";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+}
+
+#endif
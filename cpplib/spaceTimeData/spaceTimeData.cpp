@@ -24,9 +24,11 @@ void spaceTimeData::clear() {
   data_currentWindow.resize(0);;
   lineCurrent= 0;
   recNumber= 0;
+  lineFirstData= 0;
   // Buffer
   indexBuffer= 0;
   nRecsInBuffer= 0;
+  nBufferLoads= 0;
   buffer.clear();
   // Times
   time_recordStart.set(0);
@@ -120,6 +122,7 @@ void spaceTimeData::read_data() {
       }
     }
     indexBuffer= 0;
+    nBufferLoads++;
   }
 
   // Throw an exception if buffer is empty (happens if the end of file is
@@ -265,10 +268,19 @@ void spaceTimeData::init(const string &file, const string &chars_colsep,
     except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
   }
+  lineFirstData= lineCurrent;
   // Allocate data vectors
   data_recordStart.resize(locations.size());
   data_recordEnd.resize(locations.size());
   data_currentWindow.resize(locations.size());
+  read_firstRecords();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Read the first two data records and initialize the current window
+////////////////////////////////////////////////////////////////////////////////
+
+void spaceTimeData::read_firstRecords() {
   // Try to read the first TWO data records
   try {
     // Read first and second data record
@@ -292,6 +304,41 @@ void spaceTimeData::init(const string &file, const string &chars_colsep,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Return to the first records of the file
+////////////////////////////////////////////////////////////////////////////////
+
+// Note: The addresses of the current values (see 'get_address') remain valid.
+void spaceTimeData::rewind() {
+  if (empty()) {
+		except e(__PRETTY_FUNCTION__,"Data object is empty.",__FILE__,__LINE__);
+		throw(e);
+  }
+  if ((nBufferLoads == 1) && ifs.eof()) {
+    // All records are held in the buffer
+    indexBuffer= 0;
+  } else {
+    // Re-position the file behind the location IDs
+    ifs.clear();
+    ifs.seekg(0, ios::beg);
+    lineCurrent= 0;
+    try {
+      read_locations();
+    } catch (except) {
+      stringstream errmsg;
+      errmsg << "Cannot rewind file '" << filepath << "'.";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+    indexBuffer= 0;
+    nRecsInBuffer= 0;
+    nBufferLoads= 0;
+  }
+  lineCurrent= lineFirstData;
+  recNumber= 0;
+  read_firstRecords();
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Get vector of location IDs
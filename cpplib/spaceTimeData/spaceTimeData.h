@@ -27,6 +27,9 @@ NOTES:
   a larger buffer size may lead to faster execution as more data are read in a
   single disk operation without (or with less) repositioning of the head. Of
   courcse, using a large buffer increases memory consumption. 
+- The 'rewind' method returns to the state after initialization, i.e. data can
+  be read again from the beginning (e.g. for repeated simulations). If the
+  buffer holds all records of the file, no file access is required.
 - There is one basic restriction on the resolution of the query time window and
   the time interval of the data stored in the file: Basically, the query time
   window must never touch multiple time intervals present in the file.
@@ -145,9 +148,11 @@ class spaceTimeData {
     // Counters
     unsigned int lineCurrent;
     unsigned int recNumber;
+    unsigned int lineFirstData;   // Value of 'lineCurrent' after reading the location IDs
     // Record buffer
     unsigned int indexBuffer;
     unsigned int nRecsInBuffer;
+    unsigned int nBufferLoads;
     vector<string> buffer;
     // Times
     fixedZoneTime time_recordStart;
@@ -160,6 +165,7 @@ class spaceTimeData {
     // Private methods
     void read_locations();
     void read_data();
+    void read_firstRecords();
     // Don't allow assignment and use of the copy ctor because of the ifstream
     // member by making these methods private and omitting the definition
     spaceTimeData(const spaceTimeData &x);
@@ -175,6 +181,8 @@ class spaceTimeData {
       const string &chars_comment, const bool valuesAssignedToEndOfInterval,
       const bool reduceByTimeFraction, const unsigned int bufferSize);
     void clear();
+    // Return to the first records of the file
+    void rewind();
     // Get vector of location IDs
     const vector<string>& get_locations() const;
     // Return current value for a specified location
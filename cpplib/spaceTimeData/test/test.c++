@@ -53,6 +53,12 @@ int main() {
       // Update time
       t= t + dt;
     }  
+    // Rewind and read the first window again
+    dat.rewind();
+    t= t_ini;
+    dat.update(t, t+dt);
+    dat.get_times_currentWindow(t1, t2);
+    cout << "# After rewind: " << t1.get("-",":"," ") << "\t" << t2.get("-",":"," ") << "\t" << dat.get_value(locIndex) << endl;
     dat.clear();
 
 	} catch (except) {
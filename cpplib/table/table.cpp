@@ -4,18 +4,45 @@
 /*******************************************************************************
 Constructor
 *******************************************************************************/
-table::table() {
+table::table() : indexes(NULL) {
   numcols= 0;
   numrows= 0;
+  index_searchcolumn= 0;
+}
+
+/*******************************************************************************
+Copy constructor and assignment (indexes are not copied but rebuilt if needed)
+*******************************************************************************/
+table::table(const table &tab) : indexes(NULL) {
+  numcols= tab.numcols;
+  numrows= tab.numrows;
+  arena= tab.arena;
+  cells= tab.cells;
+  colnames= tab.colnames;
+  index_searchcolumn= tab.index_searchcolumn;
+}
+
+table& table::operator=(const table &tab) {
+  if (this != &tab) {
+    clear();
+    numcols= tab.numcols;
+    numrows= tab.numrows;
+    arena= tab.arena;
+    cells= tab.cells;
+    colnames= tab.colnames;
+    index_searchcolumn= tab.index_searchcolumn;
+  }
+  return(*this);
 }
 
 /*******************************************************************************
 Delete table data
 *******************************************************************************/
 void table::clear() {
-  data.clear();
+  string().swap(arena);         // Release memory of large tables immediately
+  vector<T_cell>().swap(cells);
   colnames.clear();
-  searchmap.clear();
+  drop_indexes();
   numrows= 0;
   numcols= 0;
   index_searchcolumn= 0;
@@ -28,6 +55,21 @@ table::~table() {
   clear();
 }
 
+/*******************************************************************************
+Private methods to access/add elements in the character arena
+*******************************************************************************/
+string table::cell_string(const size_type index) const {
+  return( string(arena, cells[index].offset, cells[index].length) );
+}
+
+void table::append_cell(const char* chars, const size_type length) {
+  T_cell c;
+  c.offset= arena.size();
+  c.length= length;
+  arena.append(chars, length);
+  cells.push_back(c);
+}
+
 /*******************************************************************************
 Query table dimensions
 *******************************************************************************/
@@ -66,6 +108,13 @@ table::size_type table::colindex (const string &colname) const {
   return(index_col);
 }
 
+/*******************************************************************************
+Test whether a column exists (an empty table has no columns)
+*******************************************************************************/
+bool table::has_col (const string &colname) const {
+  return(find(colnames.begin(), colnames.end(), colname) != colnames.end());
+}
+
 /*******************************************************************************
 Return a single table element (lower bound for indices is 1!)
 *******************************************************************************/
@@ -90,7 +139,7 @@ string table::get_element(const size_type index_row, const size_type index_col)
     except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
   }
-  return( data[(index_row-1)*numcols + index_col - 1] );
+  return( cell_string((index_row-1)*numcols + index_col - 1) );
 }
 
 /*******************************************************************************
@@ -111,7 +160,7 @@ void table::get_row(const size_type index, vector<string> &strvect) const {
   }
   strvect.resize(numcols);
   for (size_type i=0; i<numcols; i++) {
-    strvect[i]= data[(index-1)*numcols + i];
+    strvect[i]= cell_string((index-1)*numcols + i);
   }
 }
 
@@ -130,12 +179,143 @@ void table::get_col(const size_type index, vector<string> &strvect) const {
   }
   strvect.resize(numrows);
   for (size_type i=0; i<numrows; i++) {
-    strvect[i]= data[(index-1) + i*numcols];
+    strvect[i]= cell_string((index-1) + i*numcols);
   }
 }
 
 /*******************************************************************************
-Select a column as the search column (puts row indices of elements in multimap).
+Indexes of single columns or combinations of columns
+*******************************************************************************/
+
+// Separator of the values in the key of a multi-column index. Elements read
+// from a file cannot contain this character.
+const char KEYSEP= '\n';
+
+// Delete all indexes (must not be called concurrently with lookups)
+void table::drop_indexes() {
+  const T_indexNode* node= indexes.load(memory_order_relaxed);
+  while (node != NULL) {
+    const T_indexNode* next= node->next;
+    delete node;
+    node= next;
+  }
+  indexes.store(NULL, memory_order_relaxed);
+}
+
+// Check column indices used for an index
+void table::check_colindices(const size_type* colindices, const size_type n) const {
+  if (table::empty()) {
+    except e(__PRETTY_FUNCTION__,"Table is empty.",__FILE__,__LINE__);
+    throw(e);
+  }
+  if (n == 0) {
+    except e(__PRETTY_FUNCTION__,"Vector of column indices is empty.",__FILE__,__LINE__);
+    throw(e);
+  }
+  for (size_type i=0; i<n; i++) {
+    if ((colindices[i] < 1) || (colindices[i] > numcols)) {
+      stringstream errmsg;
+      errmsg << "Column index (" << colindices[i] << ") out of range." <<
+        " Index must be in range [1," << numcols << "] for this table.";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+  }
+}
+
+// Key of a row (lower bound for the row index is 1!)
+string table::make_key(const size_type index_row, const size_type* colindices,
+  const size_type n) const {
+  string key= cell_string((index_row-1)*numcols + colindices[0] - 1);
+  for (size_type k=1; k<n; k++) {
+    const T_cell &c= cells[(index_row-1)*numcols + colindices[k] - 1];
+    key+= KEYSEP;
+    key.append(arena, c.offset, c.length);
+  }
+  return(key);
+}
+
+// Return the index for a set of columns (built if not yet existing). Row
+// indices are stored in ascending order.
+const table::T_index& table::get_index(const size_type* colindices,
+  const size_type n) const {
+  // Search existing indexes without lock (an index is never modified once it
+  // has been published)
+  const T_indexNode* head= indexes.load(memory_order_acquire);
+  for (const T_indexNode* node= head; node != NULL; node= node->next) {
+    if ((node->colindices.size() == n) &&
+        equal(colindices, colindices + n, node->colindices.begin()))
+      return(node->index);
+  }
+  // Build the index (unless another thread did so in the meantime)
+  lock_guard<mutex> lock(indexes_mutex);
+  const T_indexNode* first= indexes.load(memory_order_relaxed);
+  for (const T_indexNode* node= first; node != head; node= node->next) {
+    if ((node->colindices.size() == n) &&
+        equal(colindices, colindices + n, node->colindices.begin()))
+      return(node->index);
+  }
+  T_indexNode* node= new T_indexNode();
+  node->colindices.assign(colindices, colindices + n);
+  node->index.reserve(numrows);
+  for (size_type i=1; i<=numrows; i++) {  // Let row indices start at 1 !
+    node->index[make_key(i, colindices, n)].push_back(i);
+  }
+  node->next= first;
+  indexes.store(node, memory_order_release);
+  return(node->index);
+}
+
+// Return pointer to the row indices matching the values (NULL if no match)
+const vector<table::size_type>* table::find_rows(const size_type* colindices,
+  const string* values, const size_type n) const {
+  check_colindices(colindices, n);
+  const T_index &index= get_index(colindices, n);
+  T_index::const_iterator it;
+  if (n == 1) {
+    it= index.find(values[0]);
+  } else {
+    // Buffer for the key of multi-column searches (memory is reused)
+    static thread_local string key;
+    key= values[0];
+    for (size_type k=1; k<n; k++) {
+      key+= KEYSEP;
+      key+= values[k];
+    }
+    it= index.find(key);
+  }
+  if (it == index.end()) {
+    return(NULL);
+  } else {
+    return(&(it->second));
+  }
+}
+
+const vector<table::size_type>* table::find_rows(const vector<size_type> &colindices,
+  const vector<string> &values) const {
+  if (values.size() != colindices.size()) {
+    stringstream errmsg;
+    errmsg << "Number of search values (" << values.size() << ") does not" <<
+      " match the number of search columns (" << colindices.size() << ").";
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  return(find_rows(colindices.data(), values.data(), values.size()));
+}
+
+// Build an index in advance (e.g. before parallel lookups)
+void table::build_index(const size_type index_col) const {
+  check_colindices(&index_col, 1);
+  get_index(&index_col, 1);
+}
+
+void table::build_index(const vector<size_type> &index_cols) const {
+  check_colindices(index_cols.data(), index_cols.size());
+  get_index(index_cols.data(), index_cols.size());
+}
+
+/*******************************************************************************
+Select a column as the default search column and build its index.
 *******************************************************************************/
 void table::update_searchcolumn(const size_type index_col) {
   if ((index_col < 1) || (index_col > numcols))  {
@@ -147,75 +327,58 @@ void table::update_searchcolumn(const size_type index_col) {
     throw(e);
   }
   index_searchcolumn= index_col;
-  searchmap.clear();
-  for (unsigned int i=0; i<numrows; i++) {
-    searchmap.insert(T_searchmap_pair(data[(index_searchcolumn-1)+(i*numcols)],
-      (i+1))); // Let row indices start at 1 !
-  }
+  get_index(&index_col, 1);
 }
 
 /*******************************************************************************
-Find first or all matching row(s) based on search in a column.
+Find first or all matching row(s) based on search in a column or in a
+combination of columns.
 *******************************************************************************/
 
 // The function returns the index of the FIRST (!) row matching the search criterion.
 // Indices start at 1. If there is no matching row, the returned value is 0.
-// Note: Update of the seach column is not done inside this method to keep it
-//       a const method.
 table::size_type table::first_row(const size_type index_col_filter,
   const string &searchstring) const {
-  if (table::empty()) {
-    except e(__PRETTY_FUNCTION__,"Table is empty.",__FILE__,__LINE__);
-    throw(e);
-  }
-  // Check index of search column (also ensures that index is not out of range)
-  if (index_col_filter != index_searchcolumn) {
-    stringstream errmsg;
-    errmsg << "Selected filter column (index " << index_col_filter <<
-      ") is not the currently active search column (index " <<
-      index_searchcolumn << "). Update the latter before calling this method.";
-    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-    throw(e);
+  const vector<size_type>* rows= find_rows(&index_col_filter, &searchstring, 1);
+  if (rows != NULL) {      // One or more matches found
+    return((*rows)[0]);    // Return row index of first match
+  } else {
+    return(0);             // Return 0 if no match was found
   }
-  // Find index of first matching row
-  pair<T_searchmap::const_iterator, T_searchmap::const_iterator> pos=
-    searchmap.equal_range(searchstring);
-  if (distance(pos.first,pos.second) > 0) {  // One or more matches found
-    return(pos.first->second);               // Return row index of first match
+}
+
+table::size_type table::first_row(const vector<size_type> &index_cols_filter,
+  const vector<string> &searchstrings) const {
+  const vector<size_type>* rows= find_rows(index_cols_filter, searchstrings);
+  if (rows != NULL) {      // One or more matches found
+    return((*rows)[0]);    // Return row index of first match
   } else {
-    return(0);                               // Return 0 if no match was found
+    return(0);             // Return 0 if no match was found
   }
 }
 
 // The function returns the index of all rows meeting the search criterion
 // The array of row indices is passed by reference (indices start at 1 !).
 // If no matches were found, the returned vector of indices is empty.
-// Note: Update of the seach column is not done inside this method to keep it
-//       a const method.
 void table::which_rows(const size_type index_col_filter,
   const string &searchstring, vector<size_type> &indices) const
 {
-  if (table::empty()) {
-    except e(__PRETTY_FUNCTION__,"Table is empty.",__FILE__,__LINE__);
-    throw(e);
-  }
-  // Check index of search column (also ensures that index is not out of range)
-  if (index_col_filter != index_searchcolumn) {
-    stringstream errmsg;
-    errmsg << "Selected filter column (index " << index_col_filter <<
-      ") is not the currently active search column (index " <<
-      index_searchcolumn << "). Update the latter before calling this method.";
-    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-    throw(e);
+  const vector<size_type>* rows= find_rows(&index_col_filter, &searchstring, 1);
+  if (rows != NULL) {
+    indices= *rows;
+  } else {
+    indices.clear();
   }
-  // Find row index by search in the filter column
-  indices.clear();
-  pair<T_searchmap::const_iterator, T_searchmap::const_iterator> pos=
-    searchmap.equal_range(searchstring);
-  if (distance(pos.first,pos.second) > 0) {  // One or more matches found 
-    for (T_searchmap::const_iterator iter=pos.first; iter!=pos.second; iter++) {
-      indices.push_back(iter->second);
-    }
+}
+
+void table::which_rows(const vector<size_type> &index_cols_filter,
+  const vector<string> &searchstrings, vector<size_type> &indices) const
+{
+  const vector<size_type>* rows= find_rows(index_cols_filter, searchstrings);
+  if (rows != NULL) {
+    indices= *rows;
+  } else {
+    indices.clear();
   }
 }
 
@@ -242,7 +405,7 @@ void table::subset(const vector<size_type> &rowindices, table &tab) const {
   tab.numcols= numcols;
   tab.numrows= rowindices.size();
   tab.colnames.resize(numcols);
-  tab.data.resize(numcols*rowindices.size());
+  tab.cells.reserve(numcols*rowindices.size());
   // Set colnames
   for (size_type i=0; i<numcols; i++)
     tab.colnames[i]= colnames[i];
@@ -256,16 +419,12 @@ void table::subset(const vector<size_type> &rowindices, table &tab) const {
 		  throw(e);
 		}
     for (size_type k=0; k<numcols; k++) {
-      tab.data[i*numcols+k]= data[(rowindices[i]-1)*numcols+k];
+      const T_cell &c= cells[(rowindices[i]-1)*numcols+k];
+      tab.append_cell(arena.data() + c.offset, c.length);
     }
 	}
-  // Update search column in the new table (keep column index unchanged)
-  try {
-    tab.update_searchcolumn(index_searchcolumn);
-  } catch (except) {
-    except e(__PRETTY_FUNCTION__,"Update of search column failed.",__FILE__,__LINE__);
-    throw(e);
-  }
+  // Keep search column in the new table (index is built when needed)
+  tab.index_searchcolumn= index_searchcolumn;
 }
 
 /*******************************************************************************
@@ -283,21 +442,17 @@ void table::insert_row(const vector<string> &values, const bool at_end) {
       except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
       throw(e);
   }
-  // Insert the values
-  if (at_end) {
-    data.insert(data.end(), values.begin(), values.end());
-  } else {
-    data.insert(data.begin(), values.begin(), values.end());
+  // Insert the values (characters are always appended to the arena)
+  for (size_type k=0; k<numcols; k++) {
+    append_cell(values[k].data(), values[k].size());
+  }
+  if (!at_end) {
+    rotate(cells.begin(), cells.end() - numcols, cells.end());
   }
   // Update the table's dimension parameters
   numrows++;
-  // Update search column (keep column index unchanged)
-  try {
-    update_searchcolumn(index_searchcolumn);
-  } catch (except) {
-    except e(__PRETTY_FUNCTION__,"Update of search column failed.",__FILE__,__LINE__);
-    throw(e);
-  }
+  // Drop existing indexes (rebuilt when needed)
+  drop_indexes();
 }
 
 /*******************************************************************************
@@ -320,7 +475,7 @@ void table::subset_cols(const vector<size_type> &colindices, table &tab) const {
   tab.numcols= colindices.size();
   tab.numrows= numrows;
   tab.colnames.resize(colindices.size());
-  tab.data.resize(colindices.size()*numrows);
+  tab.cells.reserve(colindices.size()*numrows);
 
   // Set colnames
   for (size_type i=0; i<colindices.size(); i++) {
@@ -338,16 +493,12 @@ void table::subset_cols(const vector<size_type> &colindices, table &tab) const {
   for (size_type i=0; i<numrows; i++) {
     for (size_type k=0; k<colindices.size(); k++) {
       // Range of colum index already checked when setting column names
-      tab.data[i*colindices.size()+k]= data[i*numcols+(colindices[k]-1)];
+      const T_cell &c= cells[i*numcols+(colindices[k]-1)];
+      tab.append_cell(arena.data() + c.offset, c.length);
     }
   }
-  // Define column 1 as current search column
-  try {
-    tab.update_searchcolumn(1);
-  } catch (except) {
-    except e(__PRETTY_FUNCTION__,"Update of search column failed.",__FILE__,__LINE__);
-    throw(e);
-  }
+  // Define column 1 as current search column (index is built when needed)
+  tab.index_searchcolumn= 1;
 }
 
 /*******************************************************************************
@@ -400,131 +551,256 @@ void table::set_colname(const size_type index, const string &colname) {
 /*******************************************************************************
 Read table of strings from a text file
 *******************************************************************************/
+
+// The file is read into the character arena with a single bulk read. The
+// positions of the lines are then determined for chunks of the buffer in
+// parallel and the data lines are split into elements in parallel. Elements
+// are stored as offset/length pairs refering to the arena, i.e. strings are
+// only created when an element is actually requested.
+// The rules for skipping of lines and the splitting of lines into elements are
+// the same as for a line-by-line processing using 'getline' and 'split'.
+
+namespace {
+
+  // Location of a (non-blank, non-comment) line in the buffer
+  struct T_line {
+    size_t begin;
+    size_t end;        // Position of the terminating '\n' (or end of buffer)
+    size_t number;     // Line number in file (starting at 1)
+  };
+
+  // Lookup table for a set of characters
+  struct T_charset {
+    bool member[256];
+    T_charset(const string &chars) {
+      for (unsigned int i=0; i<256; i++) member[i]= false;
+      for (unsigned int i=0; i<chars.size(); i++)
+        member[static_cast<unsigned char>(chars[i])]= true;
+    }
+    bool contains(const char c) const {
+      return(member[static_cast<unsigned char>(c)]);
+    }
+  };
+
+  // Split the characters [begin,end) of a buffer into tokens, equivalent to
+  // 'split' (stringmanip). Returns the number of tokens. The positions of
+  // at most 'nmax' tokens are stored in 'offsets' and 'lengths'.
+  unsigned int tokenize(const char* buf, const size_t begin, const size_t end,
+    const T_charset &sep, size_t* offsets, unsigned int* lengths,
+    const unsigned int nmax)
+  {
+    unsigned int ntokens= 0;
+    size_t pos= begin;
+    // Leading blanks are skipped (even if not separators)
+    while ((pos < end) && ((buf[pos] == ' ') || (buf[pos] == '\t') || (buf[pos] == '\n')))
+      pos++;
+    while (pos < end) {
+      size_t stop= pos;
+      while ((stop < end) && (!sep.contains(buf[stop]))) stop++;
+      if (stop > pos) {
+        if (ntokens < nmax) {
+          offsets[ntokens]= pos;
+          lengths[ntokens]= static_cast<unsigned int>(stop - pos);
+        }
+        ntokens++;
+      }
+      pos= stop;
+      while ((pos < end) && (sep.contains(buf[pos]))) pos++;
+    }
+    return(ntokens);
+  }
+
+  // Find the data lines in the chunk [begin,end) of a buffer. The chunk must
+  // start at the beginning of a line. Returns the number of lines started in
+  // the chunk (including blank and comment lines). Line numbers are relative
+  // to the chunk.
+  size_t find_lines(const char* buf, const size_t begin, const size_t end,
+    const T_charset &comment, vector<T_line> &lines)
+  {
+    size_t n= 0;
+    size_t pos= begin;
+    while (pos < end) {
+      const char* nl= static_cast<const char*>(memchr(buf+pos, '\n', end-pos));
+      const size_t stop= (nl == NULL) ? end : static_cast<size_t>(nl - buf);
+      n++;
+      // Exclude the carriage return of CRLF line endings (file is read in
+      // binary mode, so it is not removed by the stream as in text mode)
+      size_t last= stop;
+      if ((last > pos) && (buf[last-1] == '\r'))
+        last--;
+      // Skip blank/whitespace lines and comment lines
+      size_t first= pos;
+      while ((first < last) && ((buf[first] == ' ') || (buf[first] == '\t')))
+        first++;
+      if ((first < last) && (!comment.contains(buf[first]))) {
+        T_line line;
+        line.begin= pos;
+        line.end= last;
+        line.number= n;
+        lines.push_back(line);
+      }
+      pos= stop + 1;
+    }
+    return(n);
+  }
+
+} // End of anonymous namespace
+
 void table::read(const string &file, const bool &header, const string &chars_colsep,
   const string &chars_comment) {
-  size_type n;
-  size_type i;
-  size_type i_first;
-  string line;
-  string::size_type strpos;
-  vector<string> tokens;
-  size_type ntokens;
-  ifstream ifile;
+  const size_t CHUNKSIZE= 4194304;  // Bytes per chunk in parallel search for lines
   short has_header= static_cast<short>(header);
-  // Open input file
-  ifile.open(file.c_str());
+  ifstream ifile;
+  // Read entire file into the arena
+  clear();
+  ifile.open(file.c_str(), ios::in | ios::binary);
   if (!ifile.is_open()) {
     stringstream errmsg;
     errmsg << "Unable to open file '" << file << "' for reading.";
     except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
   }
-  // Determine number of rows
-  n= 0;
-  i= 0;
-  while(!ifile.eof()) {
-    i++;
-    getline(ifile,line);
-	  strpos= line.find_first_not_of(" \t\n");    // Find first non-blank position
-	  if (strpos != string::npos) {               // Skip blank/whitespace lines
-      if (line.substr(strpos,1).find_first_of(chars_comment) == string::npos) { // Skip comment lines
-        n++;                                    // Count row
-      }
-	  }
+  ifile.seekg(0, ios::end);
+  streamoff nbytes= ifile.tellg();
+  ifile.seekg(0, ios::beg);
+  if (nbytes > 0) {
+    arena.resize(static_cast<size_t>(nbytes));
+    ifile.read(&arena[0], nbytes);
+    if (ifile.gcount() != nbytes) {
+      arena.clear();
+      stringstream errmsg;
+      errmsg << "Failed to read contents of file '" << file << "'.";
+      except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+      throw(e);
+    }
+  }
+  ifile.close();
+  const char* buf= arena.data();
+  const size_t size= arena.size();
+  const T_charset sep(chars_colsep);
+  const T_charset comment(chars_comment);
+  // Split buffer into chunks starting at the beginning of a line
+  vector<size_t> chunks(1, 0);
+  for (size_t pos=CHUNKSIZE; pos<size; pos+=CHUNKSIZE) {
+    const char* nl= static_cast<const char*>(memchr(buf+pos, '\n', size-pos));
+    if (nl == NULL) break;
+    pos= static_cast<size_t>(nl - buf) + 1;
+    if (pos >= size) break;
+    chunks.push_back(pos);
+  }
+  chunks.push_back(size);
+  const size_t nchunks= chunks.size() - 1;
+  // Find data lines in each chunk
+  vector< vector<T_line> > chunklines(nchunks);
+  vector<size_t> nlines(nchunks);
+  #pragma omp parallel for schedule(dynamic) if(nchunks > 1)
+  for (size_t c=0; c<nchunks; c++) {
+    nlines[c]= find_lines(buf, chunks[c], chunks[c+1], comment, chunklines[c]);
+  }
+  // Collect data lines and convert line numbers to global numbers
+  vector<T_line> lines;
+  size_t nbefore= 0;
+  for (size_t c=0; c<nchunks; c++) {
+    for (size_t i=0; i<chunklines[c].size(); i++) {
+      chunklines[c][i].number+= nbefore;
+      lines.push_back(chunklines[c][i]);
+    }
+    vector<T_line>().swap(chunklines[c]);
+    nbefore+= nlines[c];
   }
-	ifile.close();
   // Save and check number of rows
-  numrows= n - has_header;
-  if (numrows <= 0) {
+  if (lines.size() <= static_cast<size_t>(has_header)) {
+    clear();
     stringstream errmsg;
     errmsg << "File '" << file << "' does not contain (usable) data.";
     except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
     throw(e);
   }
-  // Determine number of columns from first row and read matrix (checking ncols in each row)
-  ifile.open(file.c_str());
-  n= 0;
-  i= 0;
-  i_first= 0;
-  while(!ifile.eof()) {
-    i++;
-    getline(ifile,line);
-	  strpos= line.find_first_not_of(" \t\n");
-	  if (strpos != string::npos) {
-      if (line.substr(strpos,1).find_first_of(chars_comment) == string::npos) {
-        n++;
-        // Split line into tokens
-        ntokens= split(line, tokens, chars_colsep);
-        if (ntokens == 0) {
+  numrows= lines.size() - has_header;
+  // Determine number of columns from first row
+  const size_t i_first= lines[0].number;
+  numcols= tokenize(buf, lines[0].begin, lines[0].end, sep, NULL, NULL, 0);
+  if (numcols == 0) {
+    stringstream errmsg;
+    errmsg << "Unable to determine number of tokens at line " <<
+      i_first << " of file '" << file << "'.";
+    clear();
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
+  }
+  vector<size_t> offsets(numcols);
+  vector<unsigned int> lengths(numcols);
+  tokenize(buf, lines[0].begin, lines[0].end, sep, &offsets[0], &lengths[0], numcols);
+  // Set column names from file header and check if unique
+  colnames.resize(numcols);
+  if (has_header) {
+    for (size_type k=0; k<numcols; k++) {
+      colnames[k]= string(buf + offsets[k], lengths[k]);
+      for (size_type m=0; m<k; m++) {
+        if (colnames[k] == colnames[m]) {
           stringstream errmsg;
-			    errmsg << "Unable to determine number of tokens at line " <<
-            i << " of file '" << file << "'.";
-					except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-					throw(e);
+          errmsg << "Column name '" << colnames[k] <<
+            "' is not unique in file '" << file << ".";
+          clear();
+          except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+          throw(e);
+        }
+      }
+    }
+  // Make column names if not provided
+  } else {
+    for (size_type k=0; k<numcols; k++) {
+      colnames[k]= "x" + as_string(k);
+    }
+  }
+  // Split the data lines into elements (checking ncols in each row)
+  // Elements are stored by row, i.e. the matrix
+  //   "a" "b" "c"
+  //   "d" "e" "f"
+  // is stored as vector ("a" "b" "c" "d" "e" "f").
+  cells.resize(static_cast<size_t>(numrows) * numcols);
+  size_t bad_row= numrows;   // First row with inconsistent number of tokens
+  #pragma omp parallel if(numrows > 10000)
+  {
+    vector<size_t> offs(numcols);
+    vector<unsigned int> lens(numcols);
+    #pragma omp for schedule(static)
+    for (size_t i=0; i<numrows; i++) {
+      const T_line &line= lines[i + has_header];
+      unsigned int ntokens= tokenize(buf, line.begin, line.end, sep,
+        &offs[0], &lens[0], numcols);
+      if (ntokens != numcols) {
+        #pragma omp critical (table_read_badrow)
+        {
+          if (i < bad_row) bad_row= i;
         }
-        if (n == 1) {
-	        // Allocate matrix based on the number of tokens in the first row
-          i_first= i;
-          numcols= ntokens;
-          colnames.resize(numcols);          
-          data.resize(numrows*numcols);
-          // Set column names from file header and check if unique
-		      if (has_header) {
-						for (size_type k=0; k<numcols; k++) {
-				      colnames[k]= tokens[k];
-							if (k > 0) {
-    						for (size_type m=0; m<k; m++) {
-                  if (colnames[k] == colnames[m]) {
-										stringstream errmsg;
-										errmsg << "Column name '" << colnames[k] <<
-                      "' is not unique in file '" << file << ".";
-										except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-										throw(e);
-                  }
-                }
-              }
-						}
-          // Make column names if not provided
-		      } else {
-						for (size_type k=0; k<numcols; k++) {
-				      colnames[k]= "x" + as_string(k);
-						}
-          }
-				// Check that the number of elements in each row is consistent
-        } else {
-          if (ntokens != numcols) {
-		        stringstream errmsg;
-			      errmsg << "Number of tokens at line " << i << 
-              " of file '" << file << "' is " << ntokens <<
-              " but the header/top line (line " << i_first << ") has " << numcols <<
-              " token(s). Assuming columns to be separated by '" << chars_colsep << "'.";
-						except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
-						throw(e);
-          }
+      } else {
+        for (size_type k=0; k<numcols; k++) {
+          cells[i*numcols+k].offset= offs[k];
+          cells[i*numcols+k].length= lens[k];
         }
-        // Save the data of the current row in 1D array
-        // Array is filled by row, i.e. the matrix
-        //   "a" "b" "c"
-        //   "d" "e" "f"
-        // is stored as vector ("a" "b" "c" "d" "e" "f").
-        // If header==TRUE, the first line is stored in the colnames array.
-        if ((n > 1) || (!has_header)) {  // Ignore first row if there is a header
-					for (size_type k=0; k<numcols; k++) {
-		        data[(n-has_header-1)*numcols+k]= tokens[k];
-					}
-				}
-        tokens.clear();
       }
-		}
+    }
   }
-	ifile.close();
-  // Initialize search map (using first column)
-  try {
-    update_searchcolumn(1);
-  } catch (except) {
-		except e(__PRETTY_FUNCTION__,"Initialization of search column (1) failed.",__FILE__,__LINE__);
-		throw(e);
+  if (bad_row < numrows) {
+    const T_line &line= lines[bad_row + has_header];
+    unsigned int ntokens= tokenize(buf, line.begin, line.end, sep, NULL, NULL, 0);
+    stringstream errmsg;
+    if (ntokens == 0) {
+      errmsg << "Unable to determine number of tokens at line " <<
+        line.number << " of file '" << file << "'.";
+    } else {
+      errmsg << "Number of tokens at line " << line.number <<
+        " of file '" << file << "' is " << ntokens <<
+        " but the header/top line (line " << i_first << ") has " << numcols <<
+        " token(s). Assuming columns to be separated by '" << chars_colsep << "'.";
+    }
+    clear();
+    except e(__PRETTY_FUNCTION__,errmsg,__FILE__,__LINE__);
+    throw(e);
   }
+  // Define column 1 as search column (index is built when needed)
+  index_searchcolumn= 1;
 }
 
 /*******************************************************************************
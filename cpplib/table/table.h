@@ -8,6 +8,11 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
 
 #include "../except/except.h"
 #include "../typeconv/typeconv.h"
@@ -21,22 +26,52 @@ class table {
   public:
     // Types
     typedef unsigned int size_type;
-    typedef multimap<string, size_type> T_searchmap;  // Map to save values of a column and its row indices
-    typedef pair<string, size_type> T_searchmap_pair; // Single pair of the map
+    typedef unordered_map<string, vector<size_type> > T_index;  // Map of values (keys) to row indices
   private:
+    // Location of a single table element in the character arena
+    struct T_cell {
+      size_t offset;
+      size_type length;
+    };
     // Private data
     size_type numcols;
     size_type numrows;
-    vector<string> data;
+    string arena;          // Characters of all elements (e.g. the entire input file)
+    vector<T_cell> cells;  // Elements stored by row, refering to the arena
     vector<string> colnames;
-    T_searchmap searchmap;
     size_type index_searchcolumn;
+    // Indexes of single columns or combinations of columns. An index is built
+    // when first needed (or in advance, see 'build_index') and all indexes are
+    // dropped if the table is modified. The indexes form a list which only
+    // grows as long as the table is not modified: A new index is built under
+    // the mutex and then published at the head of the list. Lookups by
+    // multiple threads thus require no lock once the index exists.
+    struct T_indexNode {
+      vector<size_type> colindices;
+      T_index index;
+      const T_indexNode* next;
+    };
+    mutable atomic<const T_indexNode*> indexes;
+    mutable mutex indexes_mutex;
     // Private methods
+    string cell_string(const size_type index) const;
+    void append_cell(const char* chars, const size_type length);
+    void drop_indexes();
+    void check_colindices(const size_type* colindices, const size_type n) const;
+    string make_key(const size_type index_row, const size_type* colindices,
+      const size_type n) const;
+    const T_index& get_index(const size_type* colindices, const size_type n) const;
+    const vector<size_type>* find_rows(const size_type* colindices,
+      const string* values, const size_type n) const;
+    const vector<size_type>* find_rows(const vector<size_type> &colindices,
+      const vector<string> &values) const;
     void export_to_file(const vector<size_type> &colindices, const vector<size_type> &rowindices,
       const string &file, const string &colsep, const bool &replace) const;
   public:
     // Constructors, destructors
     table();
+    table(const table &tab);
+    table& operator=(const table &tab);
     ~table();
     // Methods to query table dimensions
     size_type nrow() const;
@@ -48,14 +83,26 @@ class table {
     void set_colname(const size_type index, const string &colname);
     // Method to convert a column name to the column index
     size_type colindex(const string &colname) const;
-    // Update search column (stores search column in a map)
+    // Method to test whether a column exists
+    bool has_col(const string &colname) const;
+    // Select the default search column and build its index (optional since
+    // any column can be searched, see below)
     void update_searchcolumn(const size_type index_col);
+    // Methods to build the index for a column or a combination of columns in
+    // advance (e.g. before a parallel loop); otherwise built when first needed
+    void build_index(const size_type index_col) const;
+    void build_index(const vector<size_type> &index_cols) const;
     // Method to retrieve the index of the first matching row (>=1; 0 if no match)
     table::size_type first_row(const size_type index_col_filter,
       const string &searchstring) const;
+    table::size_type first_row(const vector<size_type> &index_cols_filter,
+      const vector<string> &searchstrings) const;
     // Method to retrieve an array of row indices based on search in a column
+    // or in a combination of columns (all values must match)
     void which_rows(const size_type index_col_filter, const string &searchstring,
       vector<size_type> &indices) const;
+    void which_rows(const vector<size_type> &index_cols_filter,
+      const vector<string> &searchstrings, vector<size_type> &indices) const;
     // Method to retrieve a single element using its col/row index
     string get_element(const size_type index_row,
       const size_type index_col) const;
@@ -51,6 +51,7 @@ int main() {
     // Elev --> flow --> elev
     flow= xs.return_flow(elev, slope);
     cout << "q (h = " << elev << ")= " << flow << endl;
+    cout << "k (h = " << elev << ")= " << xs.return_conveyance(elev) << endl;
     elev= xs.return_surface(flow, slope, 0.001, 200);
     cout << "h (q = " << flow << ")= " << elev << endl;
 
@@ -16,75 +16,6 @@ xsection_zone::~xsection_zone() {
   point.clear();
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Returns stage dependent functions for a single zone
-////////////////////////////////////////////////////////////////////////////////
-void xsection_zone::return_stagefunctions(const double wselev,
-  double &flowarea, double &topwidth, double &wetperim) const
-{
-  const double ZERO=0.0, TWO=2.0, HALF=0.5;
-  double flowarea_sum, topwidth_sum, wetperim_sum;
-  double minelev, maxelev, offsetdiff;
-  // Code
-  flowarea_sum= ZERO;
-  topwidth_sum= ZERO;
-  wetperim_sum= ZERO;
-  for (unsigned int i=0; i<(point.size()-1); i++) {
-    minelev= min(point[i].elev, point[i+1].elev);
-    maxelev= max(point[i].elev, point[i+1].elev);
-    offsetdiff= abs(point[i].offset - point[i+1].offset);
-    // If stage is completely below the bottom
-    if (wselev <= minelev) {
-      topwidth= ZERO;
-      flowarea= ZERO;
-      wetperim= ZERO;
-    // If bottom between adjacent points is completely submerged
-    } else if (wselev >= maxelev) {
-      topwidth= offsetdiff;
-      flowarea= ((wselev - point[i].elev) + (wselev - point[i+1].elev)) /
-        TWO * topwidth;
-      wetperim= pow((pow((point[i].elev - point[i+1].elev),TWO)
-        + pow(topwidth,TWO)), HALF);
-    // If bottom is only partially submerged
-    } else {
-      topwidth= offsetdiff * ((wselev - minelev) / (maxelev - minelev)); 
-      flowarea= topwidth * (wselev - minelev) / TWO;
-      wetperim= pow( (pow(topwidth,TWO) + pow((wselev - minelev),TWO)), HALF);          
-    }
-    flowarea_sum= flowarea_sum + flowarea;
-    topwidth_sum= topwidth_sum + topwidth;
-    wetperim_sum= wetperim_sum + wetperim;
-  }
-  flowarea= flowarea_sum;
-  topwidth= topwidth_sum;
-  wetperim= wetperim_sum;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-// Returns the flow through a single zone according to mannings equation
-////////////////////////////////////////////////////////////////////////////////
-double xsection_zone::return_flow(const double wselev, const double slope) const
-{
-  const double EXPO=2.0/3.0, ZERO=0.0, HALF=0.5, NEGATIVE=-1.0;
-  double flow, flowarea, topwidth, wetperim, hydradius;
-  // Code
-  return_stagefunctions(wselev, flowarea, topwidth, wetperim);
-  if (wetperim > ZERO) {
-    hydradius= flowarea / wetperim;
-    if (slope > ZERO) {
-      flow= rough * pow(slope, HALF) * pow(hydradius, EXPO) * flowarea;
-    } else if (slope < ZERO) {
-      flow= NEGATIVE * rough * pow(abs(slope), HALF) *
-        pow(hydradius, EXPO) * flowarea;
-    } else {
-      flow= ZERO;
-    }
-  } else {
-    flow= ZERO;
-  }
-  return(flow);
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 // METHODS OF CLASS 'XSECTION'
@@ -96,11 +27,7 @@ double xsection_zone::return_flow(const double wselev, const double slope) const
 ////////////////////////////////////////////////////////////////////////////////
 xsection::xsection() {}
 xsection::~xsection() {
-  coordinates3d= false;
-  name_river= "";
-  name_reach= "";
-  station= 0.0;
-  zone.clear();
+  clear();
 }
 void xsection::clear() {
   coordinates3d= false;
@@ -108,6 +35,18 @@ void xsection::clear() {
   name_reach= "";
   station= 0.0;
   zone.clear();
+  seg_low.clear();
+  seg_height.clear();
+  seg_invheight.clear();
+  seg_width.clear();
+  zone_firstseg.clear();
+  tab_level.clear();
+  tab_area.clear();
+  tab_width.clear();
+  tab_perim.clear();
+  tab_dwidth.clear();
+  tab_dperim.clear();
+  tab_conveyance.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -121,7 +60,7 @@ void xsection::read(
   const bool read3d, const bool readrough, const double defaultrough,
   const double position_nodata
 ) {
-  const double ZERO=0.0, TWO=2.0, HALF=0.5;
+  const double ZERO=0.0;
   table tab;
   vector<string> strings;
   vector<double> x, y, offset, elev, rough;
@@ -166,8 +105,8 @@ void xsection::read(
         if (i == 0) {
           offset[i]= ZERO;
         } else {
-          offset[i]= offset[i-1] +
-            pow(pow((x[i]-x[i-1]),TWO) + pow((y[i]-y[i-1]),TWO), HALF);
+          offset[i]= offset[i-1] + sqrt((x[i]-x[i-1]) * (x[i]-x[i-1]) +
+            (y[i]-y[i-1]) * (y[i]-y[i-1]));
         }
       }
     // 3d-format, default roughness
@@ -185,8 +124,8 @@ void xsection::read(
         if (i == 0) {
           offset[i]= ZERO;
         } else {
-          offset[i]= offset[i-1] +
-            pow(pow((x[i]-x[i-1]),TWO) + pow((y[i]-y[i-1]),TWO), HALF);
+          offset[i]= offset[i-1] + sqrt((x[i]-x[i-1]) * (x[i]-x[i-1]) +
+            (y[i]-y[i-1]) * (y[i]-y[i-1]));
         }
       }
     // offset-format, given roughness
@@ -282,6 +221,179 @@ void xsection::read(
       zone[zoneindex].rough = rough[i-1];
     }
   }
+  // Precompute hydraulic tables
+  build_tables();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Set up the arrays holding the geometry of the segments
+////////////////////////////////////////////////////////////////////////////////
+void xsection::build_segments() {
+  const double ZERO=0.0, UNITY=1.0;
+  double elev0, elev1;
+  seg_low.clear();
+  seg_height.clear();
+  seg_invheight.clear();
+  seg_width.clear();
+  zone_firstseg.resize(zone.size() + 1);
+  for (unsigned int z=0; z<zone.size(); z++) {
+    zone_firstseg[z]= seg_low.size();
+    const vector<xsection_point> &point= zone[z].point;
+    for (unsigned int i=0; i<(point.size()-1); i++) {
+      elev0= point[i].elev;
+      elev1= point[i+1].elev;
+      seg_low.push_back(min(elev0, elev1));
+      seg_height.push_back(abs(elev0 - elev1));
+      seg_invheight.push_back((elev0 != elev1) ? UNITY / abs(elev0 - elev1) : ZERO);
+      seg_width.push_back(abs(point[i].offset - point[i+1].offset));
+    }
+  }
+  zone_firstseg[zone.size()]= seg_low.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the exact stage dependent functions of a single zone for an array of
+// stages (used to build the tables)
+////////////////////////////////////////////////////////////////////////////////
+
+// The submerged fraction of a segment's height is clamped to [0, 1]. With the
+// submerged width w and height h, the area is w * (depth - h/2) and the wetted
+// perimeter is sqrt(w^2 + h^2). This covers dry, partially, and completely
+// submerged segments without branches, so the inner loop can be vectorized.
+void xsection::sweep_zone(const unsigned int z, const double* wselev,
+  const unsigned int n, double* flowarea, double* topwidth,
+  double* wetperim) const
+{
+  const double ZERO=0.0, HALF=0.5, UNITY=1.0;
+  for (unsigned int k=0; k<n; k++) {
+    flowarea[k]= ZERO;
+    topwidth[k]= ZERO;
+    wetperim[k]= ZERO;
+  }
+  for (unsigned int i=zone_firstseg[z]; i<zone_firstseg[z+1]; i++) {
+    const double low= seg_low[i];
+    const double height= seg_height[i];
+    const double invheight= seg_invheight[i];
+    const double width= seg_width[i];
+    for (unsigned int k=0; k<n; k++) {
+      const double depth= max(wselev[k] - low, ZERO);
+      // Horizontal segments are either dry or submerged
+      const double frac= (height > ZERO) ? min(depth * invheight, UNITY) :
+        ((depth > ZERO) ? UNITY : ZERO);
+      const double w= width * frac;
+      const double h= height * frac;
+      topwidth[k]+= w;
+      flowarea[k]+= w * (depth - HALF * h);
+      wetperim[k]+= sqrt(w * w + h * h);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Build the tables of hydraulic properties
+////////////////////////////////////////////////////////////////////////////////
+
+// The values and rates of change above a level are computed from the exact
+// functions of the zones at two stages inside the interval to the next level.
+// This yields the limits from above which differ from the values at the level
+// itself where a horizontal segment is located at that level. Above the
+// highest level, all segments are submerged and the top width and wetted
+// perimeter are constant.
+void xsection::build_tables() {
+  const double ZERO=0.0, QUARTER=0.25, HALF=0.5, UNITY=1.0, THREE=3.0;
+  const unsigned int nzones= zone.size();
+  unsigned int nlevels, k;
+  double dh, dk;
+  vector<double> stage, area, width, perim;
+  // Geometry of segments
+  build_segments();
+  // Collect distinct elevations
+  tab_level.clear();
+  for (unsigned int i=0; i<nzones; i++) {
+    for (unsigned int n=0; n<zone[i].point.size(); n++) {
+      tab_level.push_back(zone[i].point[n].elev);
+    }
+  }
+  sort(tab_level.begin(), tab_level.end());
+  tab_level.erase(unique(tab_level.begin(), tab_level.end()), tab_level.end());
+  nlevels= tab_level.size();
+  // Stages to be evaluated: For each level, the level itself and two stages
+  // in the interval above it (one stage above the highest level)
+  for (unsigned int j=0; j<nlevels; j++) {
+    stage.push_back(tab_level[j]);
+    if (j < (nlevels-1)) {
+      dh= tab_level[j+1] - tab_level[j];
+      stage.push_back(tab_level[j] + QUARTER * dh);
+      stage.push_back(tab_level[j] + THREE * QUARTER * dh);
+    } else {
+      stage.push_back(tab_level[j] + UNITY);
+    }
+  }
+  area.resize(stage.size());
+  width.resize(stage.size());
+  perim.resize(stage.size());
+  // Tabulate stage functions of the zones
+  tab_area.resize(nlevels * nzones);
+  tab_width.resize(nlevels * nzones);
+  tab_perim.resize(nlevels * nzones);
+  tab_dwidth.resize(nlevels * nzones);
+  tab_dperim.resize(nlevels * nzones);
+  for (unsigned int z=0; z<nzones; z++) {
+    sweep_zone(z, &stage[0], stage.size(), &area[0], &width[0], &perim[0]);
+    for (unsigned int j=0; j<nlevels; j++) {
+      k= j * nzones + z;
+      const unsigned int s= 3 * j;  // Position of the level in 'stage'
+      tab_area[k]= area[s];
+      if (j < (nlevels-1)) {
+        dh= tab_level[j+1] - tab_level[j];
+        tab_dwidth[k]= (width[s+2] - width[s+1]) / (HALF * dh);
+        tab_dperim[k]= (perim[s+2] - perim[s+1]) / (HALF * dh);
+        tab_width[k]= width[s+1] - tab_dwidth[k] * QUARTER * dh;
+        tab_perim[k]= perim[s+1] - tab_dperim[k] * QUARTER * dh;
+      } else {
+        tab_dwidth[k]= ZERO;
+        tab_dperim[k]= ZERO;
+        tab_width[k]= width[s+1];
+        tab_perim[k]= perim[s+1];
+      }
+    }
+  }
+  // Tabulate the conveyance at the upper end of the intervals between levels.
+  // The conveyance is continuous within an interval but drops at a level where
+  // a horizontal segment is submerged (the wetted perimeter increases while
+  // the flow area does not). Hence, the running maximum is stored, so the
+  // first interval where the conveyance reaches a value can be found by
+  // binary search.
+  tab_conveyance.resize(nlevels - 1);
+  for (unsigned int j=0; j<(nlevels-1); j++) {
+    tab_conveyance[j]= return_conveyance_level(j, tab_level[j+1], dk);
+    if (j > 0) tab_conveyance[j]= max(tab_conveyance[j], tab_conveyance[j-1]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the table entry for a stage (returns false if the xsection is dry)
+////////////////////////////////////////////////////////////////////////////////
+bool xsection::find_level(const double wselev, unsigned int &j) const {
+  if (tab_level.empty() || (!(wselev > tab_level[0]))) return(false);
+  j= (upper_bound(tab_level.begin(), tab_level.end(), wselev) -
+    tab_level.begin()) - 1;
+  return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Stage dependent functions of a zone from the table entry for level j
+////////////////////////////////////////////////////////////////////////////////
+void xsection::return_stagefunctions_zone(const unsigned int j,
+  const unsigned int z, const double wselev, double &flowarea,
+  double &topwidth, double &wetperim) const
+{
+  const double HALF=0.5;
+  const unsigned int k= j * zone.size() + z;
+  const double d= wselev - tab_level[j];
+  topwidth= tab_width[k] + tab_dwidth[k] * d;
+  wetperim= tab_perim[k] + tab_dperim[k] * d;
+  flowarea= tab_area[k] + d * (tab_width[k] + HALF * tab_dwidth[k] * d);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -360,18 +472,20 @@ void xsection::print(const string file, const bool replace) const {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Returns stage dependent functions for a complete cross-section
+// Returns stage dependent functions for a complete cross-section (from tables)
 ////////////////////////////////////////////////////////////////////////////////
 void xsection::return_stagefunctions(const double wselev,
   double &flowarea, double &topwidth, double &wetperim) const {
   const double ZERO= 0.0;
   double flowarea_zone, topwidth_zone, wetperim_zone;
+  unsigned int j;
   // Code
   flowarea= ZERO;
   topwidth= ZERO;
   wetperim= ZERO;
+  if (!find_level(wselev, j)) return;
   for (unsigned int i=0; i<zone.size(); i++) {
-    zone[i].return_stagefunctions(wselev, flowarea_zone, topwidth_zone,
+    return_stagefunctions_zone(j, i, wselev, flowarea_zone, topwidth_zone,
       wetperim_zone);
     flowarea= flowarea + flowarea_zone;
     topwidth= topwidth + topwidth_zone;
@@ -379,6 +493,47 @@ void xsection::return_stagefunctions(const double wselev,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Returns the conveyance of a complete xsection, i.e. the flow according to
+// mannings equation divided by the square root of the slope (from tables)
+////////////////////////////////////////////////////////////////////////////////
+double xsection::return_conveyance(const double wselev) const
+{
+  const double ZERO=0.0;
+  double dconveyance;
+  unsigned int j;
+  if (!find_level(wselev, j)) return(ZERO);
+  return(return_conveyance_level(j, wselev, dconveyance));
+}
+
+// Conveyance computed from the table entry for level j. The stage should not
+// be outside the interval from level j to the next level (the value at the
+// upper end is the limit from below). The derivative of the conveyance with
+// respect to the stage is returned in 'dconveyance'. With the hydraulic radius
+// R= A/P, the conveyance of a zone is k * A * R^(2/3) and the derivative is
+// k * R^(2/3) * (5/3 * dA/dh - 2/3 * R * dP/dh) where dA/dh is the top width.
+double xsection::return_conveyance_level(const unsigned int j,
+  const double wselev, double &dconveyance) const
+{
+  const double EXPO=2.0/3.0, ZERO=0.0, FIVETHIRDS=5.0/3.0;
+  double conveyance, flowarea, topwidth, wetperim, hydradius, factor;
+  // Note: cbrt(x*x) is used for pow(x, 2/3) as it is considerably faster
+  // Code
+  conveyance= ZERO;
+  dconveyance= ZERO;
+  for (unsigned int i=0; i<zone.size(); i++) {
+    return_stagefunctions_zone(j, i, wselev, flowarea, topwidth, wetperim);
+    if (wetperim > ZERO) {
+      hydradius= flowarea / wetperim;
+      factor= zone[i].rough * cbrt(hydradius * hydradius);
+      conveyance= conveyance + factor * flowarea;
+      dconveyance= dconveyance + factor * (FIVETHIRDS * topwidth -
+        EXPO * hydradius * tab_dperim[j * zone.size() + i]);
+    }
+  }
+  return(conveyance);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Returns the flow through a complete xsection according to mannings equation
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,39 +542,45 @@ double xsection::return_flow(const double wselev, const double slope) const
   const double ZERO=0.0;
   double flow;
   // Code
-  flow= ZERO;
-  for (unsigned int i=0; i<zone.size(); i++) {
-    flow= flow + zone[i].return_flow(wselev, slope);
+  if (slope > ZERO) {
+    flow= sqrt(slope) * return_conveyance(wselev);
+  } else if (slope < ZERO) {
+    flow= -sqrt(abs(slope)) * return_conveyance(wselev);
+  } else {
+    flow= ZERO;
   }
   return(flow);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Versions of 'return_stagefunctions' and 'return_flow' for arrays of stages
+////////////////////////////////////////////////////////////////////////////////
+void xsection::return_stagefunctions(const double* wselev, double* flowarea,
+  double* topwidth, double* wetperim, const unsigned int n) const
+{
+  for (unsigned int k=0; k<n; k++) {
+    return_stagefunctions(wselev[k], flowarea[k], topwidth[k], wetperim[k]);
+  }
+}
+void xsection::return_flow(const double* wselev, const double slope,
+  double* flow, const unsigned int n) const
+{
+  const double ZERO=0.0;
+  const double factor= (slope > ZERO) ? sqrt(slope) :
+    ((slope < ZERO) ? -sqrt(abs(slope)) : ZERO);
+  for (unsigned int k=0; k<n; k++) {
+    flow[k]= factor * return_conveyance(wselev[k]);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Returns the lowest and highest elevation in a xsection
 ////////////////////////////////////////////////////////////////////////////////
 double xsection::return_min_elevation() const {
-  double elev;
-  elev= zone[0].point[0].elev;
-  for (unsigned int i=0; i<zone.size(); i++) {
-    for (unsigned int k=0; k<zone[i].point.size(); k++) {
-      if (zone[i].point[k].elev < elev) {
-        elev= zone[i].point[k].elev;
-      }
-    }
-  }
-  return(elev);
+  return(tab_level.front());  // Distinct elevations in ascending order
 }
 double xsection::return_max_elevation() const {
-  double elev;
-  elev= zone[0].point[0].elev;
-  for (unsigned int i=0; i<zone.size(); i++) {
-    for (unsigned int k=0; k<zone[i].point.size(); k++) {
-      if (zone[i].point[k].elev > elev) {
-        elev= zone[i].point[k].elev;
-      }
-    }
-  }
-  return(elev);
+  return(tab_level.back());
 }
 
 
@@ -440,57 +601,113 @@ double xsection::return_right_elevation() const {
 double xsection::return_surface(const double flow, const double slope,
   const double absprecision, const unsigned int maxniter) const
 {
-  const double TWO=2.0;
-  double wse_lower, wse_upper, wse_middle;
-  double flow_lower, flow_upper, flow_middle;
-  double normalwse;
-  unsigned int niter;
+  const double UNITY=1.0;
+  double hint= return_min_elevation() - UNITY;  // Not used, see below
+  return(return_surface(flow, slope, absprecision, maxniter, hint));
+}
+
+// Version with a hint, i.e. an initial estimate of the water surface elevation
+// (typically the solution of the previous time step) which is updated. The
+// hint is ignored if it is not within the search interval.
+// The iteration is a Newton iteration safeguarded by bisection: The search
+// interval is narrowed in every step and a bisection step is made if the
+// Newton step would leave the interval or does not converge fast enough. The
+// flows at the bounds of the interval are computed once only.
+double xsection::return_surface(const double flow, const double slope,
+  const double absprecision, const unsigned int maxniter, double &hint) const
+{
+  const double ZERO=0.0, TWO=2.0;
+  double wse_lower, wse_upper, wse, wse_new;
+  double flow_lower, flow_upper, flow_wse, dflow;
+  double step, step_old;
+  unsigned int niter, k= 0;
   // Set initial estimates of water surface elevation for iterative solution
   wse_lower= return_min_elevation();
   wse_upper= return_min_elevation() +  // Above x-section capacity
     (return_max_elevation() - return_min_elevation()) * 2.0;
+  // For a positive slope, narrow the search interval using the table of
+  // conveyance: The lowest solution is in the first interval between levels
+  // where the conveyance reaches the required value (or above the highest
+  // level). Within the interval, the flow is computed from the interval's
+  // table entry, which is continuous up to the interval's upper end.
+  const double sqrtslope= (slope > ZERO) ? sqrt(slope) : ZERO;
+  if (slope > ZERO) {
+    k= lower_bound(tab_conveyance.begin(), tab_conveyance.end(),
+      flow / sqrtslope) - tab_conveyance.begin();
+    wse_lower= tab_level[k];
+    if (k < tab_conveyance.size()) wse_upper= tab_level[k+1];
+  }
+  // Flow and its derivative with respect to the stage (the derivative is set
+  // to zero for a slope <= 0, resulting in bisection)
+  auto flow_at= [&](const double w, double &deriv) -> double {
+    if (slope > ZERO) {
+      const double conveyance= return_conveyance_level(k, w, deriv);
+      deriv= sqrtslope * deriv;
+      return(sqrtslope * conveyance);
+    } else {
+      deriv= ZERO;
+      return(return_flow(w, slope));
+    }
+  };
+  // Calculate the flow for the bounds and exit if one of them is a solution
+  flow_lower= flow_at(wse_lower, dflow);
+  if (abs(flow_lower - flow) <= absprecision) {
+    hint= wse_lower;
+    return(wse_lower);
+  }
+  flow_upper= flow_at(wse_upper, dflow);
+  if (abs(flow_upper - flow) <= absprecision) {
+    hint= wse_upper;
+    return(wse_upper);
+  }
+  // Check whether the solution is enclosed by the estimates.
+  // The solution may be outside the search interval if the solution elevation
+  // is higher than the initial upper estimate.
+  if ((flow < flow_lower) || (flow > flow_upper)) {
+    stringstream errmsg;
+    errmsg << "Could not compute water surface elevation for steady" <<
+      " uniform flow with a flow rate of " << flow << " using a slope of " <<
+      slope << " for cross-section at river '" << name_river << "', reach '" <<
+      name_reach << "', river station " << station << ". The solution is" <<
+      " outside the expected range which is possibly due to a flow rate" <<
+      " exceeding the cross-section's capacity by far.";
+    except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
+    throw(e);
+  }
+  // Initial estimate: the hint or linear interpolation between the bounds
+  if ((hint > wse_lower) && (hint < wse_upper)) {
+    wse= hint;
+  } else {
+    wse= wse_lower + (wse_upper - wse_lower) * (flow - flow_lower) /
+      (flow_upper - flow_lower);
+  }
+  step_old= wse_upper - wse_lower;
   // Perform iteration until the normal depth is calculated
   niter= 1;
   while (true) {
-    // Calculate the flow for the estimated water levels
-    flow_lower= return_flow(wse_lower, slope);
-    flow_upper= return_flow(wse_upper, slope);
-    // Exit iteration if one of the estimates is a solution
-    if (abs(flow_lower - flow) <= absprecision) {
-      normalwse= wse_lower;
-      break;
-    } else if (abs(flow_upper - flow) <= absprecision) {
-      normalwse= wse_upper;
-      break;
-    }   
-    // Check whether the solution is enclosed by the estimates.
-    // The solution may be outside the search interval if the solution elevation
-    // is higher than the initial upper estimate.
-    if ((flow < flow_lower) || (flow > flow_upper)) {
-      stringstream errmsg;
-      errmsg << "Could not compute water surface elevation for steady" <<
-        " uniform flow with a flow rate of " << flow << " using a slope of " <<
-        slope << " for cross-section at river '" << name_river << "', reach '" <<
-        name_reach << "', river station " << station << ". The solution is" <<
-        " outside the expected range which is possibly due to a flow rate" <<
-        " exceeding the cross-section's capacity by far.";
-      except e(__PRETTY_FUNCTION__, errmsg, __FILE__, __LINE__);
-      throw(e);
-    }    
-    // Bisect the interval between the estimates and calculate the flow
-    wse_middle= wse_lower + (wse_upper-wse_lower) / TWO;
-    flow_middle= return_flow(wse_middle, slope);
-    // Exit if new estimate is a solution or adjust search interval otherwise
-    if (abs(flow_middle - flow) <= absprecision) {
-      normalwse= wse_middle;
+    // Exit if the estimate is a solution
+    flow_wse= flow_at(wse, dflow);
+    if (abs(flow_wse - flow) <= absprecision) {
       break;
     }
     // Adjust the search interval
-    if (flow_middle > flow) {
-      wse_upper= wse_middle;
-    } else if (flow_middle < flow) {
-      wse_lower= wse_middle;
-    }    
+    if (flow_wse > flow) {
+      wse_upper= wse;
+    } else {
+      wse_lower= wse;
+    }
+    // Newton step or bisection
+    wse_new= wse_lower;  // Any value outside the open interval
+    if (dflow > ZERO) {
+      wse_new= wse - (flow_wse - flow) / dflow;
+    }
+    step= abs(wse_new - wse);
+    if ((!((wse_new > wse_lower) && (wse_new < wse_upper))) ||
+      (step > (step_old / TWO))) {
+      wse_new= wse_lower + (wse_upper - wse_lower) / TWO;
+      step= abs(wse_new - wse);
+    }
+    step_old= step;
     // Check for too many iterations and set counter
     if (niter == maxniter) {
       stringstream errmsg;
@@ -504,7 +721,8 @@ double xsection::return_surface(const double flow, const double slope,
       throw(e);
     }
     niter++;
+    wse= wse_new;
   }
-  return(normalwse);
+  hint= wse;
+  return(wse);
 }
-
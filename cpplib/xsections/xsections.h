@@ -18,6 +18,8 @@
 #include <iostream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 #include "../except/except.h"
 #include "../typeconv/typeconv.h"
@@ -42,10 +44,6 @@ class xsection_zone {
   private:
     vector<xsection_point> point;
     double rough;      // property of the zone (though it is read for points)
-    // Hydraulics methods
-    void return_stagefunctions(const double wselev, double &flowarea,
-      double &topwidth, double &wetperim) const;
-    double return_flow(const double wselev, const double slope) const;
   public:
     // Constructor/destructor
     xsection_zone();
@@ -64,6 +62,40 @@ class xsection {
     string name_reach;
     double station;
     vector<xsection_zone> zone;
+    // Geometry of the segments between adjacent points of all zones (one array
+    // per property). The segments of zone z have the indices zone_firstseg[z]
+    // to zone_firstseg[z+1]-1.
+    vector<double> seg_low;        // Lower elevation of the two points
+    vector<double> seg_height;     // Difference in elevation
+    vector<double> seg_invheight;  // Inverse of the above (0 if height is 0)
+    vector<double> seg_width;      // Difference in offset
+    vector<unsigned int> zone_firstseg;
+    // Precomputed hydraulic tables. Between two successive elevations of the
+    // xsection's points, the top width and the wetted perimeter of a zone are
+    // linear functions of the stage and the flow area is a quadratic one.
+    // Hence, the tables hold the values at these elevations ('levels') and the
+    // rates of change above each level. The values for any stage are then
+    // computed exactly from the entry of the next lower level.
+    // Data of zones are stored contiguously for each level, i.e. the index of
+    // level j and zone z is j*zone.size()+z.
+    vector<double> tab_level;      // Distinct elevations (ascending)
+    vector<double> tab_area;       // Flow area at level
+    vector<double> tab_width;      // Top width just above level
+    vector<double> tab_perim;      // Wetted perimeter just above level
+    vector<double> tab_dwidth;     // Derivative of top width w.r.t. stage above level
+    vector<double> tab_dperim;     // Derivative of wetted perimeter w.r.t. stage above level
+    vector<double> tab_conveyance; // Running maximum of the conveyance at the upper end of the intervals
+    // Methods related to the tables
+    void build_segments();
+    void sweep_zone(const unsigned int z, const double* wselev,
+      const unsigned int n, double* flowarea, double* topwidth,
+      double* wetperim) const;
+    void build_tables();
+    bool find_level(const double wselev, unsigned int &j) const;
+    void return_stagefunctions_zone(const unsigned int j, const unsigned int z,
+      const double wselev, double &flowarea, double &topwidth, double &wetperim) const;
+    double return_conveyance_level(const unsigned int j, const double wselev,
+      double &dconveyance) const;
   public:
     // Constructor/destructor
     xsection();
@@ -93,9 +125,16 @@ class xsection {
     // Hydraulics methods
     void return_stagefunctions(const double wselev, double &flowarea,
       double &topwidth, double &wetperim) const;
+    void return_stagefunctions(const double* wselev, double* flowarea,
+      double* topwidth, double* wetperim, const unsigned int n) const;
     double return_flow(const double wselev, const double slope) const;
+    void return_flow(const double* wselev, const double slope, double* flow,
+      const unsigned int n) const;
+    double return_conveyance(const double wselev) const;
     double return_surface(const double flow, const double slope,
       const double absprecision, const unsigned int maxniter) const;
+    double return_surface(const double flow, const double slope,
+      const double absprecision, const unsigned int maxniter, double &hint) const;
 };
 
 #endif
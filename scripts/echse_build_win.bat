@@ -14,7 +14,7 @@ if not exist %script% (
   exit
 )
 
-bash -c "%script% %1"
+bash -c "%script% %1 %2"
 if not errorlevel 0 (
   echo Error: Failed to run script '%script%'.
   echo 